@@ -1,592 +1,1022 @@
 #include "raylib.h"
+#include "rlgl.h"
+#include "snake_moteur.h"
+#include "snake_telemetrie.h"
+#include "snake_profil.h"
+#include "snake_replay.h"
+#include "snake_sauvegarde.h"
+#include "snake_paquet.h"
+#include "snake_pilote.h"
+#include "snake_niveau.h"
+#include "snake_son.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
-// dfinitions des dimensions du jeu
+// dfinitions des dimensions de l'affichage
 #define taille_carre 20            // taille d'un carr en pixels
-#define largeur_jeu 30             // nombre de carrs en largeur
-#define hauteur_jeu 20             // nombre de carrs en hauteur
-#define largeur_ecran (largeur_jeu * taille_carre)
-#define hauteur_ecran (hauteur_jeu * taille_carre)
-#define duree_fruit_bonus 50       // dure d'affichage du fruit bonus (5 secondes  10 fps)
+#define largeur_fenetre_max 1280   // au-del, la fentre ne montre qu'une partie du plateau
+#define hauteur_fenetre_max 800
+#define chemin_sauvegarde "partie.snk"   // partie sauvegarde avec F5, reprise avec F9
+
+// taille de la fentre, choisie au lancement selon la taille du plateau
+int largeur_ecran;
+int hauteur_ecran;
 
 // variables globales pour les mdias
 Texture2D texture_fond;
-Sound son_manger;
-Sound son_bonus;
-Sound son_game_over;
-Sound son_background;
-Sound son_vitesse;
-
-// types de fruits que le serpent peut manger
-typedef enum {
-    fruit_normal = 0,       // fruit normal (pomme)
-    fruit_bonus_score,      // bonus: +5 points
-    fruit_bonus_vitesse,    // bonus: acclre temporairement le serpent
-    fruit_bonus_taille      // bonus: ajoute 3 segments d'un coup
-} type_fruit;
-
-// directions possibles pour le serpent
-typedef enum {
-    dir_haut = 0,
-    dir_bas,
-    dir_gauche,
-    dir_droite
-} direction;
-
-// structure pour reprsenter une position sur la grille
+RenderTexture2D texture_plateau;   // grille d'un bloc du plateau, dessine une seule fois
+RenderTexture2D texture_hud;       // textes du haut de l'cran, redessins seulement s'ils changent
+#define hauteur_hud 70
+
+// texte fixe: sa place dans la fentre est calcule une seule fois (placer_textes)
+typedef struct {
+    const char* texte;
+    int taille;
+    Color couleur;
+    int x;
+    int y;
+} texte_place;
+
+texte_place textes_menu[] = {
+    { "jeu du serpent", 40, BLACK, 0, 0 },
+    { "appuyez sur entree pour jouer", 20, BLACK, 0, 0 },
+    { "utilisez les fleches pour diriger le serpent", 20, BLACK, 0, 0 },
+    { "p pour mettre en pause", 20, BLACK, 0, 0 },
+    { "f5 pour sauvegarder, f9 pour reprendre", 20, BLACK, 0, 0 },
+    { "a pour le pilote automatique", 20, BLACK, 0, 0 },
+    { "attention: le serpent meurt s'il touche un mur", 20, RED, 0, 0 },
+};
+texte_place textes_pause[] = {
+    { "pause", 40, BLACK, 0, 0 },
+    { "appuyez sur p pour continuer", 20, BLACK, 0, 0 },
+};
+texte_place textes_game_over[] = {
+    { "game over", 40, BLACK, 0, 0 },
+    { "appuyez sur entree pour rejouer", 20, BLACK, 0, 0 },
+};
+texte_place texte_vitesse = { "vitesse bonus", 20, BLUE, 0, 0 };
+texte_place texte_pilote = { "pilote", 20, DARKGREEN, 0, 0 };
+#define nb_textes(textes) ((int)(sizeof(textes) / sizeof((textes)[0])))
+
+// valeurs affiches dans texture_hud (-1:  redessiner)
 typedef struct {
-    int x;  // coordonne horizontale
-    int y;  // coordonne verticale
-} position;
+    int score;
+    int secondes_fruit;            // 0 si aucun fruit bonus
+    int vitesse;
+    int pilote;
+} etat_hud;
+etat_hud hud_affiche = { -1, -1, -1, -1 };
+
+// effets sonores: la simulation dpose des vnements dans la file du mixeur
+// et le fil audio de raylib les mlange lui-mme (voir snake_son.h)
+mixeur_son mixeur;
+AudioStream flux_effets;           // flux rempli par remplir_flux_effets
+float* echantillons_effets[nb_sons]; // effets dcods au format du mixeur
+Music musique_fond;                // lue au fil de l'eau dans le paquet, en boucle
+int musique_prete;
+int musique_demandee;              // une partie a commenc: jouer la musique ds qu'elle est prte
+paquet* paquet_ressources;        // paquet des ressources (la musique y est lue pendant tout le jeu)
+telemetrie* journal;              // vnements de jeu crits en arrire-plan (NULL si dsactiv)
+enregistreur_replay* replay;      // enregistrement de la partie en cours (NULL si dsactiv)
+pilote* pilote_auto;              // pilote automatique (touche a)
+int pilote_actif;                 // le pilote dirige le serpent  la place des flches
+
+// dernire image dessine: quand le jeu est immobile (menu, pause, fin de partie),
+// elle n'est redessine que si l'une de ces valeurs change
+typedef struct {
+    int en_menu;
+    int en_pause;
+    int game_over;
+    int nb_pas;
+    int score;
+    int pilote;
+    unsigned int fond;             // texture du fond (0 tant qu'elle n'est pas charge)
+    int clignotements;             // fruits bonus transparents (un bit par fruit)
+    int focus;
+    int reduite;
+} etat_image;
+etat_image image_affichee;
+int attente_evenements;            // EnableEventWaiting en cours
+#define duree_veille (1.0 / 30)    // tour de boucle sans dessin quand la musique doit tre alimente
+
+// file des changements de direction demands au clavier:
+// deux flches appuyes pendant le mme pas s'appliquent aux deux pas suivants
+#define taille_file_entrees 8
+#define age_max_entree 0.5         // une direction plus vieille (en secondes) est oublie
 
-// structure pour reprsenter une partie du corps du serpent
-typedef struct partie_serpent {
-    position pos;                    // position du segment
-    struct partie_serpent* next;     // pointeur vers le segment suivant
-} partie_serpent;
+typedef struct {
+    direction dir;                 // direction demande
+    double instant;                // moment de l'appui (GetTime)
+} entree;
 
-// structure pour reprsenter un fruit spcial
 typedef struct {
-    position pos;     // position du fruit
-    type_fruit type;  // type du fruit
-    int actif;       // est-il actuellement affich
-    int timer;        // temps avant qu'il disparaisse
-} fruit;
+    entree entrees[taille_file_entrees];
+    int debut;                     // indice de la plus ancienne entre
+    int nombre;                    // nombre d'entres en attente
+} file_entrees;
 
-// structure principale du jeu qui contient tout l'tat du jeu
+// ce qu'il faut pour dessiner le serpent entre deux pas de simulation
 typedef struct {
-    // utilisation d'un pointeur gnrique
-    void* premier_segment;        // pointeur vers la tte du serpent
-    direction dir_actuelle;       // direction actuelle
-    position nourriture;          // position de la nourriture rgulire
-    fruit fruit_bonus;            // fruit bonus (spcial)
-    int score;                    // score du joueur
-    int game_over;               //  jeu termin
-    int en_pause;                // jeu en pause
-    int en_menu;                 //  dans le menu
-    int compteur_fruits;          // compte le temps avant d'afficher un fruit bonus
-    int vitesse_bonus_timer;      // dure restante du bonus de vitesse
-    int vitesse_normale;          // vitesse normale du jeu en fps
-} jeu_snake;
-
-// fonction pour crer un nouveau segment de serpent
-partie_serpent* creer_segment(int x, int y) {
-    // allouer de la mmoire pour le nouveau segment
-    partie_serpent* nouveau = (partie_serpent*)malloc(sizeof(partie_serpent));
-
-    // vrifier si l'allocation a russi
-    if (nouveau == NULL) {
-        printf("erreur: impossible d'allouer de la mmoire pour un segment du serpent\n");
-        return NULL;  // retourner null en cas d'chec
-    }
-
-    // initialiser les valeurs du nouveau segment
-    nouveau->pos.x = x;
-    nouveau->pos.y = y;
-    nouveau->next = NULL;  // pas de segment suivant pour le moment
-
-    return nouveau;  // retourner le pointeur vers le nouveau segment
-}
-
-// fonction pour initialiser le jeu
-jeu_snake* initialiser_jeu() {
-    // allouer de la mmoire pour la structure du jeu
-    jeu_snake* jeu = (jeu_snake*)malloc(sizeof(jeu_snake));
-
-    if (jeu ==NULL) {
-        printf("erreur: impossible d'allouer de la mmoire pour le jeu\n");
-        return NULL;
-    }
-
-    // crer la tte du serpent au milieu de l'cran
-    partie_serpent* tete = creer_segment(largeur_jeu / 2, hauteur_jeu / 2);
-    jeu->premier_segment = tete; // stocker la tte dans le jeu
-
-    // ajouter deux segments supplmentaires au serpent
-    // 1. crer le deuxime segment  gauche de la tte
-    partie_serpent* deuxieme = creer_segment(tete->pos.x - 1, tete->pos.y);
-    // 2. lier la tte au deuxime segment
-    tete->next = deuxieme;
-
-    // 3. crer le troisime segment  gauche du deuxime
-    partie_serpent* troisieme = creer_segment(deuxieme->pos.x - 1, deuxieme->pos.y);
-    // 4. lier le deuxime segment au troisime
-    deuxieme->next = troisieme;
-
-    // initialiser les autres paramtres du jeu
-    jeu->dir_actuelle = dir_droite;  // le serpent commence vers la droite
-    jeu->score = 0;
-    jeu->game_over = 0;
-    jeu->en_pause = 0;
-    jeu->en_menu = 1;  // commencer dans le menu
-
-    // initialiser les paramtres des fruits bonus
-    jeu->fruit_bonus.actif = 0;
-    jeu->compteur_fruits = 0;
-    jeu->vitesse_bonus_timer = 0;
-    jeu->vitesse_normale = 10;  // 10 images par seconde
-
-    // placer la premire nourriture alatoirement
-    jeu->nourriture.x = GetRandomValue(0, largeur_jeu - 1);
-    jeu->nourriture.y = GetRandomValue(0, hauteur_jeu - 1);
-
-    return jeu;
-}
-
-// fonction pour librer la mmoire utilise par le serpent
-void liberer_serpent(partie_serpent* tete) {
-    partie_serpent* actuel = tete;     // commencer par la tte
-    partie_serpent* suivant;           // pour mmoriser le segment suivant
-
-    // parcourir toute la liste chane
-    while (actuel != NULL) {
-        suivant = actuel->next;        // sauvegarder le pointeur vers le segment suivant
-        free(actuel);                  // librer le segment actuel
-        actuel = suivant;              // passer au segment suivant
-    }
-}
-
-// fonction pour vrifier si une position est occupe par le serpent
-int est_sur_serpent(partie_serpent* tete, int x, int y) {
-    partie_serpent* actuel = tete;  // commencer par la tte
-
-    // parcourir tous les segments du serpent
-    while (actuel != NULL) {
-        // vrifier si les coordonnes correspondent
-        if (actuel->pos.x == x && actuel->pos.y == y) {
-            return 1;  // position occupe par le serpent
-        }
-        actuel = actuel->next;  // passer au segment suivant
-    }
-
-    return 0;  // position libre
-}
-
-// fonction pour placer une nouvelle nourriture
-void placer_nourriture(jeu_snake* jeu) {
-    partie_serpent* tete = (partie_serpent*)jeu->premier_segment;
-
-    // chercher une position libre (pas sur le serpent ni sur le fruit bonus)
-    do {
-        jeu->nourriture.x = GetRandomValue(0, largeur_jeu - 1);
-        jeu->nourriture.y = GetRandomValue(0, hauteur_jeu - 1);
-    } while (est_sur_serpent(tete, jeu->nourriture.x, jeu->nourriture.y) ||
-             (jeu->fruit_bonus.actif &&
-              jeu->fruit_bonus.pos.x == jeu->nourriture.x &&
-              jeu->fruit_bonus.pos.y == jeu->nourriture.y));
-}
-
-// fonction pour placer un fruit bonus
-void placer_fruit_bonus(jeu_snake* jeu) {
-    partie_serpent* tete = (partie_serpent*)jeu->premier_segment;
-
-    // choisir alatoirement un type de fruit bonus
-    jeu->fruit_bonus.type = GetRandomValue(fruit_bonus_score, fruit_bonus_taille);
-
-    // chercher une position libre
-    do {
-        jeu->fruit_bonus.pos.x = GetRandomValue(0, largeur_jeu - 1);
-        jeu->fruit_bonus.pos.y = GetRandomValue(0, hauteur_jeu - 1);
-    } while (est_sur_serpent(tete, jeu->fruit_bonus.pos.x, jeu->fruit_bonus.pos.y) ||
-             (jeu->fruit_bonus.pos.x == jeu->nourriture.x &&
-              jeu->fruit_bonus.pos.y == jeu->nourriture.y));
-
-    // activer le fruit et rgler sa dure
-    jeu->fruit_bonus.actif = 1;
-    jeu->fruit_bonus.timer = duree_fruit_bonus;
-}
-
-// fonction pour ajouter un segment au serpent  la fin de la liste
-void ajouter_segment(jeu_snake* jeu) {
-    // rcuprer la tte
-    partie_serpent* tete = (partie_serpent*)jeu->premier_segment;
-    partie_serpent* actuel = tete;
-    // trouver le dernier segment
-    while (actuel->next != NULL) {
-        actuel = actuel->next;
-    }
-    // crer un nouveau segment
-    partie_serpent* nouveau = creer_segment(actuel->pos.x, actuel->pos.y);
-    // lier le dernier segment au nouveau
-    actuel->next = nouveau;
-}
-
-// fonction appele quand le serpent mange un fruit bonus
-void consommer_fruit_bonus(jeu_snake* jeu) {
-    PlaySound(son_bonus);  // jouer le son du bonus
-
-    // diffrents effets selon le type de fruit
-    switch (jeu->fruit_bonus.type) {
-        case fruit_bonus_score:
-            // ajoute 5 points supplmentaires
-            jeu->score += 5;
-            break;
-
-        case fruit_bonus_vitesse:
-            // acclre temporairement le serpent
-            jeu->vitesse_bonus_timer = 50;  // 5 secondes  10 fps
-            SetTargetFPS(15);  // augmente la vitesse  15 fps
-            PlaySound(son_vitesse);
-            break;
-
-        case fruit_bonus_taille:
-            // ajoute 3 segments d'un coup
-            for (int i = 0; i < 3; i++) {
-                ajouter_segment(jeu);
-            }
-            break;
+    position ancienne_queue;       // case quitte par la queue au dernier pas
+    int queue_a_bouge;             // la queue a avanc au dernier pas
+    float avancement;              // fraction coule du pas en cours (0  1)
+} interpolation;
+
+// fonction pour savoir si deux directions sont opposes
+int directions_opposees(direction a, direction b) {
+    return (a == dir_haut && b == dir_bas) || (a == dir_bas && b == dir_haut) ||
+           (a == dir_gauche && b == dir_droite) || (a == dir_droite && b == dir_gauche);
+}
 
-        default:
-            break;
+// fonction pour ajouter une direction  la file
+void ajouter_entree(file_entrees* file, jeu_snake* jeu, direction dir, double instant) {
+    // comparer  la dernire direction demande, ou  la direction actuelle
+    direction derniere = jeu->dir_actuelle;
+    if (file->nombre > 0) {
+        derniere = file->entrees[(file->debut + file->nombre - 1) % taille_file_entrees].dir;
     }
 
-    // dsactiver le fruit bonus aprs consommation
-    jeu->fruit_bonus.actif = 0;
-}
+    // on empche de faire demi-tour et on ignore les rptitions
+    if (dir == derniere || directions_opposees(dir, derniere) || file->nombre == taille_file_entrees) {
+        return;
+    }
 
-// fonction pour grer l'tat des fruits bonus
-void mise_a_jour_fruits_bonus(jeu_snake* jeu) {
-    // si un fruit bonus est actif, diminuer son timer
-    if (jeu->fruit_bonus.actif) {
-        jeu->fruit_bonus.timer--;
+    entree* nouvelle = &file->entrees[(file->debut + file->nombre) % taille_file_entrees];
+    nouvelle->dir = dir;
+    nouvelle->instant = instant;
+    file->nombre++;
+}
 
-        // si le timer atteint zro, dsactiver le fruit
-        if (jeu->fruit_bonus.timer <= 0) {
-            jeu->fruit_bonus.actif = 0;
+// fonction pour appliquer la prochaine direction de la file avant un pas
+void appliquer_entree(file_entrees* file, jeu_snake* jeu, double maintenant) {
+    while (file->nombre > 0) {
+        entree* prochaine = &file->entrees[file->debut];
+        file->debut = (file->debut + 1) % taille_file_entrees;
+        file->nombre--;
+
+        // une seule direction par pas, toujours sans demi-tour
+        if (maintenant - prochaine->instant <= age_max_entree &&
+            !directions_opposees(prochaine->dir, jeu->dir_actuelle)) {
+            jeu->dir_actuelle = prochaine->dir;
+            return;
         }
     }
-    // si aucun fruit bonus n'est actif, grer l'apparition d'un nouveau
-    else {
-        jeu->compteur_fruits++;
+}
 
-        // faire apparatre un fruit bonus aprs un certain temps alatoire
-        if (jeu->compteur_fruits >= GetRandomValue(80, 120)) {
-            placer_fruit_bonus(jeu);
-            jeu->compteur_fruits = 0;  // rinitialiser le compteur
+// fonction pour lire les flches appuyes depuis la dernire image, dans l'ordre
+void lire_entrees(file_entrees* file, jeu_snake* jeu) {
+    int touche;
+    while ((touche = GetKeyPressed()) != 0) {
+        switch (touche) {
+            case KEY_UP:    ajouter_entree(file, jeu, dir_haut, GetTime());   break;
+            case KEY_DOWN:  ajouter_entree(file, jeu, dir_bas, GetTime());    break;
+            case KEY_LEFT:  ajouter_entree(file, jeu, dir_gauche, GetTime()); break;
+            case KEY_RIGHT: ajouter_entree(file, jeu, dir_droite, GetTime()); break;
+            default: break;
         }
     }
+}
 
-    // grer le bonus de vitesse
-    if (jeu->vitesse_bonus_timer > 0) {
-        jeu->vitesse_bonus_timer--;
+// fonction pour dessiner la grille d'un bloc dans une texture
+// elle ne change pas pendant la partie: chaque bloc visible l'affiche en une seule fois
+void preparer_plateau() {
+    texture_plateau = LoadRenderTexture(cote_bloc * taille_carre, cote_bloc * taille_carre);
 
-        // si le timer atteint zro, revenir  la vitesse normale
-        if (jeu->vitesse_bonus_timer <= 0) {
-            SetTargetFPS(jeu->vitesse_normale);
+    BeginTextureMode(texture_plateau);
+    ClearBackground(BLANK);
+    for (int i = 0; i < cote_bloc; i++) {
+        for (int j = 0; j < cote_bloc; j++) {
+            DrawRectangleLines(i * taille_carre, j * taille_carre, taille_carre, taille_carre, LIGHTGRAY);
         }
     }
+    EndTextureMode();
+}
+
+// fonction pour placer la camra sur la tte du serpent
+// (sans montrer ce qui est au-del des bords du plateau)
+Camera2D camera_jeu(jeu_snake* jeu, float avancement) {
+    position avant = *segment_serpent(jeu, 1);
+    position tete = *segment_serpent(jeu, 0);
+    float x = ((avant.x + (tete.x - avant.x) * avancement) + 0.5f) * taille_carre;
+    float y = ((avant.y + (tete.y - avant.y) * avancement) + 0.5f) * taille_carre;
+
+    float demi_largeur = largeur_ecran / 2.0f;
+    float demi_hauteur = hauteur_ecran / 2.0f;
+    float largeur_plateau = (float)jeu->largeur * taille_carre;
+    float hauteur_plateau = (float)jeu->hauteur * taille_carre;
+    if (x < demi_largeur) x = demi_largeur;
+    if (x > largeur_plateau - demi_largeur) x = largeur_plateau - demi_largeur;
+    if (y < demi_hauteur) y = demi_hauteur;
+    if (y > hauteur_plateau - demi_hauteur) y = hauteur_plateau - demi_hauteur;
+
+    Camera2D camera = { 0 };
+    camera.offset = (Vector2){ demi_largeur, demi_hauteur };
+    camera.target = (Vector2){ x, y };
+    camera.zoom = 1.0f;
+    return camera;
+}
+
+// coordonnes, dans la texture des formes de raylib, du texel blanc qui colore les carrs
+// (en 0..1, fixes par commencer_carres)
+float texel_gauche, texel_haut, texel_droite, texel_bas;
+
+// fonction pour commencer le lot de carrs envoy en une fois  la carte graphique
+// les carrs sont dessins avec la texture des formes, comme DrawRectangle:
+// sans elle, ils seraient chantillonns dans la dernire texture utilise (la grille)
+void commencer_carres(int nb_carres) {
+    Texture2D formes = GetShapesTexture();
+    Rectangle rect = GetShapesTextureRectangle();
+    texel_gauche = rect.x / formes.width;
+    texel_haut = rect.y / formes.height;
+    texel_droite = (rect.x + rect.width) / formes.width;
+    texel_bas = (rect.y + rect.height) / formes.height;
+
+    rlCheckRenderBatchLimit(4 * nb_carres);
+    rlSetTexture(formes.id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+}
+
+// fonction pour terminer le lot de carrs
+void terminer_carres() {
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// fonction pour ajouter un carr au lot de carrs
+// ( appeler entre commencer_carres et terminer_carres)
+void ajouter_carre(float x, float y, Color couleur) {
+    rlColor4ub(couleur.r, couleur.g, couleur.b, couleur.a);
+    rlTexCoord2f(texel_gauche, texel_haut);
+    rlVertex2f(x, y);
+    rlTexCoord2f(texel_gauche, texel_bas);
+    rlVertex2f(x, y + taille_carre);
+    rlTexCoord2f(texel_droite, texel_bas);
+    rlVertex2f(x + taille_carre, y + taille_carre);
+    rlTexCoord2f(texel_droite, texel_haut);
+    rlVertex2f(x + taille_carre, y);
+}
+
+// fonction pour ajouter une case du serpent entre deux positions
+// (avancement 0 = position de dpart, 1 = position d'arrive)
+void ajouter_case_glissante(position depart, position arrivee, float avancement, Color couleur) {
+    ajouter_carre((depart.x + (arrivee.x - depart.x) * avancement) * taille_carre,
+                  (depart.y + (arrivee.y - depart.y) * avancement) * taille_carre, couleur);
+}
+
+// fonction pour centrer un texte fixe sur une ligne de la fentre
+void centrer_texte(texte_place* t, int y) {
+    t->x = largeur_ecran/2 - MeasureText(t->texte, t->taille)/2;
+    t->y = y;
+}
+
+// fonction pour calculer une fois pour toutes la place des textes fixes
+// (la fentre doit tre ouverte pour mesurer les textes)
+void placer_textes() {
+    centrer_texte(&textes_menu[0], hauteur_ecran/4);
+    for (int i = 1; i < nb_textes(textes_menu); i++) {
+        centrer_texte(&textes_menu[i], hauteur_ecran/2 + 30 * (i - 1));
+    }
+    centrer_texte(&textes_pause[0], hauteur_ecran/2 - 40);
+    centrer_texte(&textes_pause[1], hauteur_ecran/2 + 20);
+    centrer_texte(&textes_game_over[0], hauteur_ecran/2 - 40);
+    centrer_texte(&textes_game_over[1], hauteur_ecran/2 + 20);
+
+    // indicateurs aligns  droite
+    texte_vitesse.x = largeur_ecran - MeasureText(texte_vitesse.texte, texte_vitesse.taille) - 10;
+    texte_vitesse.y = 10;
+    texte_pilote.x = largeur_ecran - MeasureText(texte_pilote.texte, texte_pilote.taille) - 10;
+    texte_pilote.y = 40;
+
+    texture_hud = LoadRenderTexture(largeur_ecran, hauteur_hud);
 }
 
-// fonction principale pour dplacer le serpent
-void deplacer_serpent(jeu_snake* jeu) {
-    // rcuprer la tte du serpent
-    partie_serpent* tete = (partie_serpent*)jeu->premier_segment;
+// fonction pour dessiner une suite de textes fixes
+void dessiner_textes(const texte_place* textes, int nombre) {
+    for (int i = 0; i < nombre; i++) {
+        DrawText(textes[i].texte, textes[i].x, textes[i].y, textes[i].taille, textes[i].couleur);
+    }
+}
 
-    // ne rien faire si le jeu est en pause ou termin
-    if (jeu->en_pause || jeu->game_over) return;
+// fonction pour savoir si un fruit bonus est dans la phase transparente de son clignotement
+// (il clignote pendant les 20 derniers pas avant de disparatre)
+int fruit_transparent(const jeu_snake* jeu, int k) {
+    int reste = temps_restant(jeu, minuteur_fruits + k);
+    return reste < 20 && (reste / 3) % 2 == 0;
+}
 
-    // tape 1: mmoriser la position actuelle de la tte
-    int ancien_x = tete->pos.x;
-    int ancien_y = tete->pos.y;
+// fonction pour crire un nombre positif en chiffres  partir de texte[position]
+void ecrire_nombre(char* texte, int position, int valeur) {
+    if (valeur == 0) {
+        texte[position++] = '0';
+        texte[position] = '\0';
+        return;
+    }
 
-    // tape 2: dplacer la tte dans la direction choisie
-    switch (jeu->dir_actuelle) {
-        case dir_haut:    tete->pos.y--; break;
-        case dir_bas:     tete->pos.y++; break;
-        case dir_gauche:  tete->pos.x--; break;
-        case dir_droite:  tete->pos.x++; break;
+    // stocker les chiffres dans un buffer temporaire
+    char chiffres[10];
+    int nb_chiffres = 0;
+    while (valeur > 0) {
+        chiffres[nb_chiffres++] = '0' + (valeur % 10);
+        valeur /= 10;
     }
 
-    // tape 3: vrifier collision avec les murs
-    if (tete->pos.x < 0 || tete->pos.x >= largeur_jeu ||
-        tete->pos.y < 0 || tete->pos.y >= hauteur_jeu) {
-        jeu->game_over = 1;
-        PlaySound(son_game_over);
-        return;  // sortir de la fonction si game over
+    // copier les chiffres dans l'ordre inverse
+    for (int i = nb_chiffres - 1; i >= 0; i--) {
+        texte[position++] = chiffres[i];
     }
+    texte[position] = '\0';
+}
 
-    // tape 4: vrifier collision avec le serpent lui-mme
-    partie_serpent* actuel = tete->next;  // commencer par le segment aprs la tte
-    while (actuel !=NULL) {
-        if (tete->pos.x == actuel->pos.x && tete->pos.y == actuel->pos.y) {
-            jeu->game_over = 1;
-            PlaySound(son_game_over);
-            return;  // sortir de la fonction si game over
+// fonction pour redessiner les textes du haut de l'cran dans leur texture,
+// seulement si le score, la seconde affiche du fruit bonus ou un indicateur a chang
+// ( appeler hors de BeginDrawing)
+void mettre_a_jour_hud(const jeu_snake* jeu) {
+    // fruit bonus qui disparatra le premier
+    int premier_fruit = -1;
+    for (int k = 0; k < nb_fruits_max; k++) {
+        if (jeu->fruits[k].actif && (premier_fruit < 0 ||
+            temps_restant(jeu, minuteur_fruits + k) < temps_restant(jeu, minuteur_fruits + premier_fruit))) {
+            premier_fruit = k;
         }
-        actuel = actuel->next;
     }
 
-    // tape 5: dplacer le corps du serpent
-    /*suivre chaque segment en lui donnant la position
-    qu'avait le segment prcdent avant le dplacement*/
-    actuel = tete->next;  // commencer par le segment aprs la tte
-    int temp_x, temp_y;
-
-    while (actuel !=NULL) {
-        // sauvegarder la position actuelle de ce segment
-        temp_x = actuel->pos.x;
-        temp_y = actuel->pos.y;
+    etat_hud etat;
+    etat.score = jeu->score;
+    etat.secondes_fruit = premier_fruit >= 0 ? temps_restant(jeu, minuteur_fruits + premier_fruit)/10 + 1 : 0;
+    etat.vitesse = temps_restant(jeu, minuteur_vitesse) > 0;
+    etat.pilote = pilote_actif;
+    if (memcmp(&etat, &hud_affiche, sizeof(etat)) == 0) {
+        return;
+    }
+    hud_affiche = etat;
 
-        // dplacer ce segment  la position du segment prcdent
-        actuel->pos.x = ancien_x;
-        actuel->pos.y = ancien_y;
+    BeginTextureMode(texture_hud);
+    ClearBackground(BLANK);
 
-        // prparer pour le segment suivant
-        ancien_x = temp_x;
-        ancien_y = temp_y;
+    // afficher le score
+    char texte_score[20] = "score: ";
+    ecrire_nombre(texte_score, 7, etat.score);
+    DrawText(texte_score, 10, 10, 20, BLACK);
 
-        // passer au segment suivant
-        actuel = actuel->next;
+    // afficher l'indicateur de bonus de vitesse
+    if (etat.vitesse) {
+        dessiner_textes(&texte_vitesse, 1);
     }
 
-    // tape 6: vrifier si la nourriture normale a t mange
-    if (tete->pos.x == jeu->nourriture.x && tete->pos.y == jeu->nourriture.y) {
-        ajouter_segment(jeu);    // grandir le serpent
-        placer_nourriture(jeu);  // placer une nouvelle nourriture
-        jeu->score++;            // augmenter le score
-        PlaySound(son_manger);   // jouer le son
+    // indiquer que le pilote automatique joue
+    if (etat.pilote) {
+        dessiner_textes(&texte_pilote, 1);
     }
 
-    // tape 7: vrifier si un fruit bonus a t mang
-    if (jeu->fruit_bonus.actif &&
-        tete->pos.x == jeu->fruit_bonus.pos.x &&
-        tete->pos.y == jeu->fruit_bonus.pos.y) {
-        consommer_fruit_bonus(jeu);
+    // afficher le temps restant pour le fruit bonus qui disparatra le premier
+    if (etat.secondes_fruit > 0) {
+        char texte_timer[20] = "fruit: ";
+        ecrire_nombre(texte_timer, 7, etat.secondes_fruit);
+        DrawText(texte_timer, 10, 40, 20, PURPLE);
     }
+    EndTextureMode();
+}
 
-    // tape 8: mettre  jour l'tat des fruits bonus
-    mise_a_jour_fruits_bonus(jeu);
+#ifdef SNAKE_PROFIL
+int afficher_profil = 0;           // tableau des mesures affich (touche F3)
+
+// fonction pour afficher les mesures du profileur par-dessus le jeu
+void dessiner_profil() {
+    if (!afficher_profil) return;
+
+    DrawRectangle(5, 5, 330, 20 + 14 * nb_phases_profil, Fade(BLACK, 0.7f));
+    DrawText("phase        p50     p99     max (us)", 10, 10, 10, WHITE);
+    for (int p = 0; p < nb_phases_profil; p++) {
+        DrawText(TextFormat("%-12s %7.1f %7.1f %7.1f", nom_phase(p),
+                            quantile_phase(p, 0.5), quantile_phase(p, 0.99), max_phase(p)),
+                 10, 24 + 14 * p, 10, WHITE);
+    }
 }
+#else
+#define dessiner_profil() ((void)0)
+#endif
 
 // fonction pour dessiner le jeu
-void dessiner_jeu(jeu_snake* jeu) {
-    // rcuprer la tte du serpent
-    partie_serpent* tete = (partie_serpent*)jeu->premier_segment;
+void dessiner_jeu(jeu_snake* jeu, interpolation* anim) {
+    if (!jeu->en_menu) {
+        mettre_a_jour_hud(jeu);
+    }
 
     BeginDrawing();
     ClearBackground(RAYWHITE);
 
-    // afficher l'image de fond
-    DrawTexture(texture_fond, 0, 0, WHITE);
+    // image de fond tire sur toute la fentre (couleur unie tant qu'elle n'est pas charge)
+    if (texture_fond.id != 0) {
+        Rectangle source_fond = { 0, 0, texture_fond.width, texture_fond.height };
+        Rectangle fenetre = { 0, 0, largeur_ecran, hauteur_ecran };
+        DrawTexturePro(texture_fond, source_fond, fenetre, (Vector2){ 0, 0 }, 0, WHITE);
+    }
 
     // si nous sommes dans le menu
     if (jeu->en_menu) {
-        DrawText("jeu du serpent", largeur_ecran/2 - MeasureText("jeu du serpent", 40)/2, hauteur_ecran/4, 40, BLACK);
-        DrawText("appuyez sur entree pour jouer", largeur_ecran/2 - MeasureText("appuyez sur entree pour jouer", 20)/2, hauteur_ecran/2, 20, BLACK);
-        DrawText("utilisez les fleches pour diriger le serpent", largeur_ecran/2 - MeasureText("utilisez les fleches pour diriger le serpent", 20)/2, hauteur_ecran/2 + 30, 20, BLACK);
-        DrawText("p pour mettre en pause", largeur_ecran/2 - MeasureText("p pour mettre en pause", 20)/2, hauteur_ecran/2 + 60, 20, BLACK);
-        DrawText("attention: le serpent meurt s'il touche un mur", largeur_ecran/2 - MeasureText("attention: le serpent meurt s'il touche un mur", 20)/2, hauteur_ecran/2 + 90, 20, RED);
+        dessiner_textes(textes_menu, nb_textes(textes_menu));
+        dessiner_profil();
         EndDrawing();
         return;
     }
 
-    // dessiner la grille de jeu
-    for (int i = 0; i < largeur_jeu; i++) {
-        for (int j = 0; j < hauteur_jeu; j++) {
-            DrawRectangleLines(i * taille_carre, j * taille_carre, taille_carre, taille_carre, LIGHTGRAY);
+    // la camra suit la tte: seule la partie visible du plateau est dessine
+    float avancement = jeu->game_over ? 1.0f : anim->avancement;
+    Camera2D camera = camera_jeu(jeu, avancement);
+    int x_min = (int)((camera.target.x - camera.offset.x) / taille_carre);
+    int y_min = (int)((camera.target.y - camera.offset.y) / taille_carre);
+    int x_max = (int)((camera.target.x - camera.offset.x + largeur_ecran) / taille_carre);
+    int y_max = (int)((camera.target.y - camera.offset.y + hauteur_ecran) / taille_carre);
+    if (x_min < 0) x_min = 0;
+    if (y_min < 0) y_min = 0;
+    if (x_max > jeu->largeur - 1) x_max = jeu->largeur - 1;
+    if (y_max > jeu->hauteur - 1) y_max = jeu->hauteur - 1;
+    BeginMode2D(camera);
+
+    PROFIL_DEBUT(profil_dessin_plateau);
+    // afficher la grille prpare par preparer_plateau sur chaque bloc visible
+    // (les textures de rendu sont  l'envers: hauteur ngative)
+    for (int by = y_min / cote_bloc; by <= y_max / cote_bloc; by++) {
+        for (int bx = x_min / cote_bloc; bx <= x_max / cote_bloc; bx++) {
+            int largeur = jeu->largeur - bx * cote_bloc < cote_bloc ? jeu->largeur - bx * cote_bloc : cote_bloc;
+            int hauteur = jeu->hauteur - by * cote_bloc < cote_bloc ? jeu->hauteur - by * cote_bloc : cote_bloc;
+            Rectangle source = { 0, 0, largeur * taille_carre, -hauteur * taille_carre };
+            Vector2 origine = { bx * cote_bloc * taille_carre, by * cote_bloc * taille_carre };
+            DrawTextureRec(texture_plateau.texture, source, origine, WHITE);
         }
     }
-
-    // dessiner la nourriture normale
-    DrawRectangle(jeu->nourriture.x * taille_carre, jeu->nourriture.y * taille_carre, taille_carre, taille_carre, RED);
-
-    // dessiner le fruit bonus s'il est actif
-    if (jeu->fruit_bonus.actif) {
-       Color couleur_fruit;
-
-        // choisir la couleur selon le type de fruit
-        switch (jeu->fruit_bonus.type) {
+    PROFIL_FIN(profil_dessin_plateau);
+
+    PROFIL_DEBUT(profil_dessin_cases);
+    // toutes les cases visibles (nourriture, fruit, serpent) partent en un seul lot
+    commencer_carres((x_max - x_min + 1) * (y_max - y_min + 1) + 2);
+
+    // parcourir les cases visibles: entre deux pas, les cases du corps ne changent pas;
+    // seules la tte et la queue glissent vers leur nouvelle case
+    position tete = *segment_serpent(jeu, 0);
+    for (int y = y_min; y <= y_max; y++) {
+        for (int x = x_min; x <= x_max; x++) {
+            switch (lire_case(jeu, x, y)) {
+                case case_nourriture:
+                    ajouter_carre(x * taille_carre, y * taille_carre, RED);
+                    break;
+                case case_serpent:
+                    if (x != tete.x || y != tete.y) {
+                        ajouter_carre(x * taille_carre, y * taille_carre, GREEN);
+                    }
+                    break;
+                case case_mur:
+                    ajouter_carre(x * taille_carre, y * taille_carre, DARKGRAY);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    // les fruits bonus de la rserve, chacun avec sa couleur
+    for (int k = 0; k < nb_fruits_max; k++) {
+        const fruit* f = &jeu->fruits[k];
+        if (!f->actif || f->pos.x < x_min || f->pos.x > x_max || f->pos.y < y_min || f->pos.y > y_max) continue;
+
+        // couleur du fruit bonus selon son type
+        Color couleur_fruit;
+        switch (f->type) {
             case fruit_bonus_score:   couleur_fruit = GOLD;   break;
             case fruit_bonus_vitesse: couleur_fruit = BLUE;   break;
             case fruit_bonus_taille:  couleur_fruit = PURPLE; break;
             default:                  couleur_fruit = ORANGE;
         }
-
         // faire clignoter le fruit quand il va disparatre
-        if (jeu->fruit_bonus.timer < 20 && (jeu->fruit_bonus.timer / 3) % 2 == 0) {
+        if (fruit_transparent(jeu, k)) {
             couleur_fruit.a = 128; // semi-transparent
         }
+        ajouter_carre(f->pos.x * taille_carre, f->pos.y * taille_carre, couleur_fruit);
+    }
+    if (anim->queue_a_bouge && !jeu->game_over) {
+        ajouter_case_glissante(anim->ancienne_queue, *segment_serpent(jeu, jeu->longueur - 1), avancement, GREEN);
+    }
+    // dessiner la tte en vert fonc
+    ajouter_case_glissante(*segment_serpent(jeu, 1), tete, avancement, DARKGREEN);
+
+    terminer_carres();
+    EndMode2D();
+    PROFIL_FIN(profil_dessin_cases);
+
+    PROFIL_DEBUT(profil_dessin_textes);
+    // textes du haut de l'cran, dj prts dans leur texture (retourne comme celle du plateau)
+    Rectangle source_hud = { 0, 0, largeur_ecran, -hauteur_hud };
+    DrawTextureRec(texture_hud.texture, source_hud, (Vector2){ 0, 0 }, WHITE);
 
-        DrawRectangle(jeu->fruit_bonus.pos.x * taille_carre, jeu->fruit_bonus.pos.y * taille_carre,
-                     taille_carre, taille_carre, couleur_fruit);
+    // afficher le message de pause
+    if (jeu->en_pause) {
+        dessiner_textes(textes_pause, nb_textes(textes_pause));
     }
 
-    // dessiner le serpent - parcourir la liste chane
-    partie_serpent* actuel = tete;
-    while (actuel != NULL) {
-        // dessiner la tte en vert fonc, le corps en vert
-        Color couleur;
-        if (actuel == tete) {
-            couleur = DARKGREEN;
-          }
-        else {
-            couleur = GREEN;
-            }
-        DrawRectangle(actuel->pos.x * taille_carre, actuel->pos.y * taille_carre,
-                     taille_carre, taille_carre, couleur);
-        actuel = actuel->next;  // passer au segment suivant
+    // afficher le message de game over
+    if (jeu->game_over) {
+        dessiner_textes(textes_game_over, nb_textes(textes_game_over));
     }
+    PROFIL_FIN(profil_dessin_textes);
 
-    // afficher le score
-    char texte_score[20];
-    //  afficher le score
-    printf("score: %d\n", jeu->score);
-    // mais pour l'affichage dans la fentre, on doit toujours prparer le texte
-    texte_score[0] = 's';
-    texte_score[1] = 'c';
-    texte_score[2] = 'o';
-    texte_score[3] = 'r';
-    texte_score[4] = 'e';
-    texte_score[5] = ':';
-    texte_score[6] = ' ';
-
-    // convertir le score en texte
-    int temp_score = jeu->score;
-    int position = 7;
-
-    if (temp_score == 0) {
-        texte_score[position++] = '0';
-        texte_score[position] = '\0';
-    } else {
-        char chiffres[10];
-        int nb_chiffres = 0;
+    dessiner_profil();
+    PROFIL_DEBUT(profil_affichage);
+    EndDrawing();
+    PROFIL_FIN(profil_affichage);
+}
+
+// fonction appele par le fil audio quand le flux des effets a besoin d'chantillons
+void remplir_flux_effets(void* tampon, unsigned int images) {
+    mixer_sons(&mixeur, (float*)tampon, (int)images);
+}
+
+// fonction pour dmarrer la musique de fond (elle continue d'une partie  l'autre)
+void jouer_musique() {
+    musique_demandee = 1;
+    if (musique_prete && !IsMusicStreamPlaying(musique_fond)) {
+        PlayMusicStream(musique_fond);
+    }
+}
+
+// fonction pour transmettre au mixeur les sons d'un pas de simulation
+// (aucun appel audio ici: seulement des critures dans la file)
+void traiter_evenements(const jeu_snake* jeu, int evenements) {
+    if (evenements & evenement_mange) {
+        emettre_son(&mixeur, son_manger, jeu->nb_pas);
+    }
+    if (evenements & evenement_bonus) {
+        emettre_son(&mixeur, son_bonus, jeu->nb_pas);
+    }
+    if (evenements & evenement_vitesse_debut) {
+        emettre_son(&mixeur, son_vitesse, jeu->nb_pas);
+    }
+    if (evenements & (evenement_mort_mur | evenement_mort_serpent)) {
+        emettre_son(&mixeur, son_game_over, jeu->nb_pas);
+    }
+}
+
+// fonction pour noter les vnements d'un pas dans le journal de tlmtrie
+// le type du fruit bonus mang est gard dans jeu->dernier_bonus
+void noter_evenements(jeu_snake* jeu, int evenements, int ancien_score) {
+    if (evenements & evenement_mange) {
+        noter_telemetrie(journal, telemetrie_fruit, fruit_normal, jeu->nb_pas, jeu->score, jeu->longueur);
+    }
+    if (evenements & evenement_bonus) {
+        noter_telemetrie(journal, telemetrie_fruit, jeu->dernier_bonus, jeu->nb_pas, jeu->score, jeu->longueur);
+    }
+    if (jeu->score != ancien_score) {
+        noter_telemetrie(journal, telemetrie_score, 0, jeu->nb_pas, jeu->score, jeu->longueur);
+    }
+    if (evenements & evenement_vitesse_debut) {
+        noter_telemetrie(journal, telemetrie_vitesse_debut, 0, jeu->nb_pas, jeu->score, jeu->longueur);
+    }
+    if (evenements & evenement_vitesse_fin) {
+        noter_telemetrie(journal, telemetrie_vitesse_fin, 0, jeu->nb_pas, jeu->score, jeu->longueur);
+    }
+    if (evenements & (evenement_mort_mur | evenement_mort_serpent)) {
+        noter_telemetrie(journal, telemetrie_game_over, evenements & (evenement_mort_mur | evenement_mort_serpent),
+                         jeu->nb_pas, jeu->score, jeu->longueur);
+    }
+}
 
-        while (temp_score > 0) {
-            chiffres[nb_chiffres++] = '0' + (temp_score % 10);
-            temp_score /= 10;
+// ressources du jeu, lues dans le paquet (option -a) et dcodes par un fil en arrire-plan
+// pour que le menu s'affiche tout de suite; le fil principal les envoie ensuite
+//  la carte graphique et  l'audio. une ressource absente reste vide:
+// un son vide est silencieux, un fond vide est remplac par une couleur unie
+// les effets sont convertis au format du mixeur (float, stro) par le fil lui-mme
+// la musique n'est pas dcode d'avance: raylib la dcode par petits morceaux
+// dans quelques tampons tournants, directement depuis le paquet
+#ifdef SNAKE_PAQUET_INTEGRE
+extern const unsigned char paquet_integre[];   // produit par paquet_main.c -c
+extern const size_t taille_paquet_integre;
+#endif
+
+enum { ressource_attente = 0, ressource_decodee, ressource_installee, ressource_absente };
+
+typedef struct {
+    const char* nom;               // nom dans le paquet
+    Texture2D* texture;            // destination d'une image
+    float** echantillons;          // ou d'un effet sonore (effet du mixeur)
+    effet_son effet;
+    Music* musique;                // ou de la musique
+    Image image;                   // donnes dcodes par le fil, pas encore installes
+    int nb_images;                 // longueur de l'effet dcod
+    const unsigned char* octets;   // donnes de la musique dans le paquet
+    size_t taille;
+    _Atomic int etat;              // ressource_attente, ressource_decodee...
+} ressource;
+
+ressource ressources[] = {
+    { .nom = "background.png", .texture = &texture_fond },
+    { .nom = "background.wav", .musique = &musique_fond },
+    { .nom = "manger.wav", .echantillons = &echantillons_effets[son_manger], .effet = son_manger },
+    { .nom = "bonus.wav", .echantillons = &echantillons_effets[son_bonus], .effet = son_bonus },
+    { .nom = "vitesse.wav", .echantillons = &echantillons_effets[son_vitesse], .effet = son_vitesse },
+    { .nom = "game_over.wav", .echantillons = &echantillons_effets[son_game_over], .effet = son_game_over },
+};
+#define nb_ressources (int)(sizeof(ressources) / sizeof(ressources[0]))
+
+pthread_t fil_chargement;
+int chargement_en_cours;           // le fil existe et n'a pas encore t attendu
+
+// fil de chargement: dcode chaque ressource directement depuis le paquet
+void* decoder_ressources(void* argument) {
+    (void)argument;
+    for (int i = 0; i < nb_ressources; i++) {
+        ressource* r = &ressources[i];
+        size_t taille = 0;
+        const unsigned char* octets = chercher_ressource(paquet_ressources, r->nom, &taille);
+        const char* extension = strrchr(r->nom, '.');
+
+        if (octets != NULL && r->texture != NULL) {
+            r->image = LoadImageFromMemory(extension, octets, (int)taille);
+        } else if (octets != NULL && r->echantillons != NULL) {
+            Wave onde = LoadWaveFromMemory(extension, octets, (int)taille);
+            if (onde.data != NULL) {
+                WaveFormat(&onde, frequence_mixeur, 32, canaux_mixeur);
+                *r->echantillons = LoadWaveSamples(onde);
+                r->nb_images = (int)onde.frameCount;
+                UnloadWave(onde);
+            }
+        } else if (octets != NULL) {
+            r->octets = octets;   // dcode pendant la lecture
+            r->taille = taille;
         }
 
-        // copier les chiffres dans l'ordre inverse
-        for (int i = nb_chiffres - 1; i >= 0; i--) {
-            texte_score[position++] = chiffres[i];
+        if (r->image.data != NULL || (r->echantillons != NULL && *r->echantillons != NULL) || r->octets != NULL) {
+            atomic_store(&r->etat, ressource_decodee);
+        } else {
+            printf("erreur: ressource absente ou illisible: %s\n", r->nom);
+            atomic_store(&r->etat, ressource_absente);
         }
-        texte_score[position] = '\0';
     }
+    return NULL;
+}
 
-    DrawText(texte_score, 10, 10, 20, BLACK);
+// fonction pour ouvrir le paquet et lancer le dcodage des ressources
+void charger_ressources(const char* chemin_paquet) {
+    // initialiser le systme audio
+    InitAudioDevice();
 
-    // afficher l'indicateur de bonus de vitesse
-    if (jeu->vitesse_bonus_timer > 0) {
-        DrawText("vitesse bonus", largeur_ecran - MeasureText("vitesse bonus", 20) - 10, 10, 20,BLUE);
-    }
-
-    // afficher le temps restant pour le fruit bonus
-    if (jeu->fruit_bonus.actif) {
-        char texte_timer[20];
-        // prparer le texte du timer
-        texte_timer[0] = 'f';
-        texte_timer[1] = 'r';
-        texte_timer[2] = 'u';
-        texte_timer[3] = 'i';
-        texte_timer[4] = 't';
-        texte_timer[5] = ':';
-        texte_timer[6] = ' ';
-
-        // convertir le timer en texte
-        int temps_restant = jeu->fruit_bonus.timer/10 + 1;
-        int position = 7;
-
-        if (temps_restant == 0) {
-            texte_timer[position++] = '0';
-            texte_timer[position] = '\0';
-        } else {
-            // stocker les chiffres dans un buffer temporaire
-            char chiffres[10];
-            int nb_chiffres = 0;
+    // flux des effets: le fil audio appelle remplir_flux_effets quand il a besoin d'chantillons
+    initialiser_mixeur(&mixeur);
+    flux_effets = LoadAudioStream(frequence_mixeur, 32, canaux_mixeur);
+    SetAudioStreamCallback(flux_effets, remplir_flux_effets);
+    PlayAudioStream(flux_effets);
+
+#ifdef SNAKE_PAQUET_INTEGRE
+    // le paquet intgr sert quand aucun fichier n'est donn
+    paquet_ressources = chemin_paquet != NULL ? ouvrir_paquet(chemin_paquet)
+                                              : ouvrir_paquet_memoire(paquet_integre, taille_paquet_integre);
+#else
+    paquet_ressources = ouvrir_paquet(chemin_paquet != NULL ? chemin_paquet : "ressources.pak");
+#endif
+
+    // sans paquet, le fil ne trouve aucune ressource: le jeu part sans images ni sons
+    if (pthread_create(&fil_chargement, NULL, decoder_ressources, NULL) == 0) {
+        chargement_en_cours = 1;
+    } else {
+        printf("erreur: impossible de lancer le chargement des ressources\n");
+    }
+}
 
-            while (temps_restant > 0) {
-                chiffres[nb_chiffres++] = '0' + (temps_restant % 10);
-                temps_restant /= 10;
+// fonction pour installer les ressources dcodes depuis l'image prcdente
+// (les textures et la musique se crent sur le fil principal)
+void installer_ressources() {
+    if (!chargement_en_cours) return;
+
+    int restantes = 0;
+    for (int i = 0; i < nb_ressources; i++) {
+        ressource* r = &ressources[i];
+        int etat = atomic_load(&r->etat);
+        if (etat == ressource_decodee) {
+            if (r->texture != NULL) {
+                *r->texture = LoadTextureFromImage(r->image);
+                UnloadImage(r->image);
+            } else if (r->echantillons != NULL) {
+                installer_son(&mixeur, r->effet, *r->echantillons, r->nb_images);
+            } else {
+                *r->musique = LoadMusicStreamFromMemory(strrchr(r->nom, '.'), r->octets, (int)r->taille);
+                r->musique->looping = true;
+                musique_prete = IsMusicReady(*r->musique);
+                if (musique_prete && musique_demandee) {
+                    PlayMusicStream(*r->musique);
+                }
             }
+            atomic_store(&r->etat, ressource_installee);
+        } else if (etat == ressource_attente) {
+            restantes++;
+        }
+    }
+
+    // tout est charg: le fil a fini
+    if (restantes == 0) {
+        pthread_join(fil_chargement, NULL);
+        chargement_en_cours = 0;
+    }
+}
 
-            // copier les chiffres dans l'ordre inverse
-            for (int i = nb_chiffres - 1; i >= 0; i--) {
-                texte_timer[position++] = chiffres[i];
+// fonction pour dcharger les ressources (mme si le chargement n'est pas fini)
+void decharger_ressources() {
+    if (chargement_en_cours) {
+        pthread_join(fil_chargement, NULL);
+        chargement_en_cours = 0;
+    }
+
+    // arrter le fil audio avant de librer les chantillons qu'il lit
+    StopAudioStream(flux_effets);
+    UnloadAudioStream(flux_effets);
+
+    // librer la mmoire des images et des sons
+    for (int i = 0; i < nb_ressources; i++) {
+        ressource* r = &ressources[i];
+        int etat = atomic_load(&r->etat);
+        if (etat == ressource_decodee) {
+            if (r->texture != NULL) UnloadImage(r->image);
+            else if (r->echantillons != NULL) UnloadWaveSamples(*r->echantillons);
+        } else if (etat == ressource_installee) {
+            if (r->texture != NULL) {
+                UnloadTexture(*r->texture);
+            } else if (r->echantillons != NULL) {
+                UnloadWaveSamples(*r->echantillons);
+            } else if (musique_prete) {
+                UnloadMusicStream(*r->musique);
             }
-            texte_timer[position] = '\0';
         }
+    }
 
-        DrawText(texte_timer, 10, 40, 20, PURPLE);
+    // la musique ne lit plus le paquet
+    fermer_paquet(paquet_ressources);
+    paquet_ressources = NULL;
+
+    // fermer le systme audio
+    CloseAudioDevice();
+}
+
+// fonction pour faire avancer la simulation du temps coul depuis la dernire image
+// la dure d'un pas dpend de la vitesse du jeu, pas du nombre d'images par seconde
+// duree_image: temps coul depuis l'image prcdente (0 juste aprs un tat immobile)
+void avancer_simulation(jeu_snake* jeu, file_entrees* file, interpolation* anim, double* accumulateur,
+                        double duree_image) {
+    double duree_pas = 1.0 / vitesse_actuelle(jeu);
+
+    *accumulateur += duree_image;
+    if (*accumulateur > 4 * duree_pas) {
+        *accumulateur = 4 * duree_pas;  // ne pas rattraper un long blocage d'un coup
     }
 
-    // afficher le message de pause
-    if (jeu->en_pause) {
-        DrawText("pause", largeur_ecran/2 - MeasureText("pause", 40)/2, hauteur_ecran/2 - 40, 40, BLACK);
-        DrawText("appuyez sur p pour continuer", largeur_ecran/2 - MeasureText("appuyez sur p pour continuer", 20)/2, hauteur_ecran/2 + 20, 20,BLACK);
+    while (*accumulateur >= duree_pas && !jeu->game_over) {
+        *accumulateur -= duree_pas;
+        if (pilote_actif) {
+            jeu->dir_actuelle = choisir_direction(pilote_auto, jeu);
+        } else {
+            appliquer_entree(file, jeu, GetTime());
+        }
+
+        // mmoriser la queue pour la faire glisser pendant le pas suivant
+        int longueur = jeu->longueur;
+        anim->ancienne_queue = *segment_serpent(jeu, longueur - 1);
+
+        int ancien_score = jeu->score;
+        PROFIL_DEBUT(profil_simulation);
+        noter_pas_replay(replay, jeu);
+        int evenements = deplacer_serpent(jeu);
+        PROFIL_FIN(profil_simulation);
+        traiter_evenements(jeu, evenements);
+        noter_evenements(jeu, evenements, ancien_score);
+        if (jeu->game_over) {
+            terminer_replay(replay, jeu);  // la partie est complte
+            replay = NULL;
+        }
+
+        anim->queue_a_bouge = jeu->longueur == longueur;
+        duree_pas = 1.0 / vitesse_actuelle(jeu);
     }
 
-    // afficher le message de game over
-    if (jeu->game_over) {
-        DrawText("game over", largeur_ecran/2 - MeasureText("game over", 40)/2, hauteur_ecran/2 - 40, 40, BLACK);
-        DrawText("appuyez sur entree pour rejouer", largeur_ecran/2 - MeasureText("appuyez sur entree pour rejouer", 20)/2, hauteur_ecran/2 + 20, 20, BLACK);
+    anim->avancement = (float)(*accumulateur / duree_pas);
+}
+
+// fonction pour savoir si le jeu est immobile (menu, pause, fin de partie) et que rien
+// d'autre n'oblige la boucle  tourner: elle peut alors attendre les vnements
+int jeu_immobile(const jeu_snake* jeu) {
+    if (!jeu->en_menu && !jeu->en_pause && !jeu->game_over) return 0;
+    if (chargement_en_cours) return 0;  // le fond et les sons arrivent sans vnement
+#ifdef SNAKE_PROFIL
+    if (afficher_profil) return 0;      // les mesures changent  chaque image
+#endif
+    return 1;
+}
+
+// fonction pour savoir si l'image  afficher a chang depuis le dernier appel
+int image_changee(const jeu_snake* jeu) {
+    etat_image etat;
+    memset(&etat, 0, sizeof(etat));
+    etat.en_menu = jeu->en_menu;
+    etat.en_pause = jeu->en_pause;
+    etat.game_over = jeu->game_over;
+    etat.nb_pas = jeu->nb_pas;
+    etat.score = jeu->score;
+    etat.pilote = pilote_actif;
+    etat.fond = texture_fond.id;
+    for (int k = 0; k < nb_fruits_max; k++) {
+        if (jeu->fruits[k].actif && fruit_transparent(jeu, k)) etat.clignotements |= 1 << k;
     }
+    etat.focus = IsWindowFocused();
+    etat.reduite = IsWindowMinimized();
 
-    EndDrawing();
+    int changee = IsWindowResized() || memcmp(&etat, &image_affichee, sizeof(etat)) != 0;
+    image_affichee = etat;
+    return changee;
 }
 
-// fonction pour charger les sons
-void charger_sons() {
-    // initialiser le systme audio
-    InitAudioDevice();
+// fonction pour activer ou couper l'attente des vnements de raylib
+// (pendant l'attente, la lecture des entres bloque jusqu'au prochain vnement)
+void attendre_evenements(int attendre) {
+    if (attendre == attente_evenements) return;
+    attente_evenements = attendre;
+    if (attendre) {
+        EnableEventWaiting();
+    } else {
+        DisableEventWaiting();
+    }
+}
+
+// graines des parties: suite de Weyl  partir d'une graine tire au lancement
+// (toujours diffrentes d'une partie  l'autre, mme si l'on recommence dans la mme seconde:
+// chaque partie a son propre enregistrement)
+uint64_t graine_lancement;
+uint64_t parties_lancees = 0;
 
-    // charger les sons
-    son_manger = LoadSound("C:/Users/pc/OneDrive/Bureau/PROJET S2/final/bin/Debug/sons/manger.wav");
-    son_bonus = LoadSound("C:/Users/pc/OneDrive/Bureau/PROJET S2/final/bin/Debug/sons/bonus.wav");
-    son_game_over = LoadSound("C:/Users/pc/OneDrive/Bureau/PROJET S2/final/bin/Debug/sons/game_over.wav");
-    son_vitesse = LoadSound("C:/Users/pc/OneDrive/Bureau/PROJET S2/final/bin/Debug/sons/vitesse.wav");
-    son_background = LoadSound("C:/Users/pc/OneDrive/Bureau/PROJET S2/final/bin/Debug/sons/background.wav");
+// fonction pour obtenir la graine de la prochaine partie
+uint64_t graine_suivante() {
+    return graine_lancement + 0x9e3779b97f4a7c15ULL * parties_lancees++;
 }
 
-// fonction pour dcharger les sons
-void decharger_sons() {
-    // librer la mmoire des sons
-    UnloadSound(son_manger);
-    UnloadSound(son_bonus);
-    UnloadSound(son_game_over);
-    UnloadSound(son_vitesse);
-    UnloadSound(son_background);
+// fonction pour commencer l'enregistrement d'une nouvelle partie dans <prefixe>_<graine>.replay
+void enregistrer_partie(const char* prefixe, const jeu_snake* jeu, uint64_t graine) {
+    if (prefixe == NULL) return;
 
-    // fermer le systme audio
-    CloseAudioDevice();
+    char chemin[512];
+    snprintf(chemin, sizeof(chemin), "%s_%llu.replay", prefixe, (unsigned long long)graine);
+    replay = commencer_replay(chemin, jeu, graine, intervalle_images_defaut);
+}
+
+// fonction pour reprendre la partie sauvegarde (touche F9), en pause
+// l'enregistrement en cours s'arrte: la partie reprise ne suit plus sa graine
+void reprendre_partie(jeu_snake* jeu, file_entrees* file, interpolation* anim, double* accumulateur) {
+    terminer_replay(replay, jeu);
+    replay = NULL;
+    if (charger_jeu(jeu, chemin_sauvegarde) != 0) {
+        return;
+    }
+
+    jeu->en_menu = 0;
+    jeu->en_pause = 1;
+    file->nombre = 0;
+    anim->queue_a_bouge = 0;
+    *accumulateur = 0;
+    noter_telemetrie(journal, telemetrie_debut_partie, 0, jeu->nb_pas, jeu->score, jeu->longueur);
+    jouer_musique();
 }
 
 // fonction principale
-int main() {
+int main(int argc, char** argv) {
+    // vitesses de la simulation en pas par seconde (options -v et -b),
+    // taille du plateau en cases (options -l et -h)
+    // fichier du journal de tlmtrie (option -t, "-" pour le dsactiver)
+    // dbut du nom des enregistrements de parties (option -r)
+    // paquet de ressources (option -a, par dfaut ressources.pak ou le paquet intgr)
+    // et carte du niveau (option -n, qui donne aussi la taille du plateau)
+    int vitesse_normale = vitesse_normale_defaut;
+    int vitesse_rapide = vitesse_bonus;
+    int largeur_plateau = largeur_jeu;
+    int hauteur_plateau = hauteur_jeu;
+    const char* chemin_journal = "telemetrie.ndjson";
+    const char* prefixe_replay = NULL;
+    const char* chemin_paquet = NULL;
+    const char* chemin_niveau = NULL;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (argv[i][0] == '-' && argv[i][1] == 'v') vitesse_normale = atoi(argv[i + 1]);
+        if (argv[i][0] == '-' && argv[i][1] == 'b') vitesse_rapide = atoi(argv[i + 1]);
+        if (argv[i][0] == '-' && argv[i][1] == 'l') largeur_plateau = atoi(argv[i + 1]);
+        if (argv[i][0] == '-' && argv[i][1] == 'h') hauteur_plateau = atoi(argv[i + 1]);
+        if (argv[i][0] == '-' && argv[i][1] == 't') chemin_journal = argv[i + 1];
+        if (argv[i][0] == '-' && argv[i][1] == 'r') prefixe_replay = argv[i + 1];
+        if (argv[i][0] == '-' && argv[i][1] == 'a') chemin_paquet = argv[i + 1];
+        if (argv[i][0] == '-' && argv[i][1] == 'n') chemin_niveau = argv[i + 1];
+    }
+    if (vitesse_normale <= 0) vitesse_normale = vitesse_normale_defaut;
+    if (vitesse_rapide <= 0) vitesse_rapide = vitesse_bonus;
+
+    // charger le niveau: ses murs et ses distances sont prts avant la premire partie
+    niveau* niv = NULL;
+    if (chemin_niveau != NULL) {
+        niv = charger_niveau(chemin_niveau);
+        if (niv == NULL) {
+            return 1;
+        }
+        largeur_plateau = niv->largeur;
+        hauteur_plateau = niv->hauteur;
+    }
+
+    // crer et initialiser le jeu (la graine change  chaque lancement et  chaque partie;
+    // l'horloge monotone dpartage deux lancements dans la mme seconde)
+    graine_lancement = (uint64_t)time(NULL) * 1000003ULL ^ (uint64_t)(horloge_secondes() * 1e9);
+    uint64_t graine = graine_suivante();
+    // toute la mmoire de la partie est rserve ds le dpart: jouer et recommencer
+    // n'allouent plus rien, mme aprs des heures (borne d'arcade)
+    jeu_snake* jeu = creer_jeu(largeur_plateau, hauteur_plateau, graine);
+    if (jeu == NULL || choisir_niveau(jeu, niv) != 0 || reserver_jeu(jeu) != 0) {
+        return 1;
+    }
+    if (niv != NULL) {
+        reinitialiser_jeu(jeu, graine);  // poser les murs
+    }
+    enregistrer_partie(prefixe_replay, jeu, graine);
+    jeu->vitesse_normale = vitesse_normale;
+    jeu->vitesse_rapide = vitesse_rapide;
+    pilote_auto = creer_pilote(largeur_plateau, hauteur_plateau);
+
+    // la fentre montre tout le plateau s'il est petit, sinon la partie autour de la tte
+    largeur_ecran = largeur_plateau * taille_carre < largeur_fenetre_max ? largeur_plateau * taille_carre : largeur_fenetre_max;
+    hauteur_ecran = hauteur_plateau * taille_carre < hauteur_fenetre_max ? hauteur_plateau * taille_carre : hauteur_fenetre_max;
+
     // initialiser la fentre
+    SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(largeur_ecran, hauteur_ecran, "jeu du serpent");
 
-    // charger l'image de fond
-    texture_fond = LoadTexture("C:/Users/pc/OneDrive/Bureau/PROJET S2/final/bin/Debug/background.png");
-    // charger les sons
-    charger_sons();
-    // configurer le jeu
-    SetTargetFPS(10);  // 10 images par seconde
-    srand(time(NULL)); // initialiser le gnrateur de nombres alatoires
+    preparer_plateau();
+    placer_textes();
+    // charger l'image de fond et les sons en arrire-plan
+    charger_ressources(chemin_paquet);
+    // dmarrer le journal (le jeu continue sans s'il ne peut pas tre ouvert)
+    if (chemin_journal[0] != '-') {
+        journal = demarrer_telemetrie(chemin_journal);
+    }
+
+    // afficher au rythme de l'cran; la simulation a sa propre cadence
+    int images_par_seconde = GetMonitorRefreshRate(GetCurrentMonitor());
+    SetTargetFPS(images_par_seconde > 0 ? images_par_seconde : 60);
 
-    // crer et initialiser le jeu
-    jeu_snake* jeu = initialiser_jeu();
+    file_entrees file = { 0 };
+    interpolation anim = { 0 };
+    double accumulateur = 0;
+    int images_faussees = 0;
 
     // boucle principale du jeu
     while (!WindowShouldClose()) {
+        PROFIL_DEBUT(profil_image);
+
+        // immobile, la boucle ne dessine pas et attend: la dure de l'image qui en sort
+        // (GetFrameTime, mesure  EndDrawing) compte toute l'attente, jusqu' l'image suivante
+        // la simulation ignore ces deux images au lieu de jouer plusieurs pas d'un coup
+        if (jeu->en_menu || jeu->en_pause || jeu->game_over) {
+            images_faussees = 2;
+        }
+        installer_ressources();
+        if (musique_prete) {
+            UpdateMusicStream(musique_fond);  // dcoder la suite de la musique
+        }
+
+#ifdef SNAKE_PROFIL
+        if (IsKeyPressed(KEY_F3)) {
+            afficher_profil = !afficher_profil;  // montrer ou cacher les mesures
+        }
+#endif
+
+        // reprendre la partie sauvegarde, depuis le menu ou en jeu
+        if (IsKeyPressed(KEY_F9)) {
+            reprendre_partie(jeu, &file, &anim, &accumulateur);
+        }
+
         // gestion du menu principal
         if (jeu->en_menu) {
             if (IsKeyPressed(KEY_ENTER)) {
                 jeu->en_menu = 0;
-            PlaySound(son_background);  // dmarrer la musique
+                accumulateur = 0;
+                noter_telemetrie(journal, telemetrie_debut_partie, 0, 0, jeu->score, jeu->longueur);
+                jouer_musique();             // dmarrer la musique
             }
         }
         // gestion de l'cran de fin de jeu
         else if (jeu->game_over) {
             if (IsKeyPressed(KEY_ENTER)) {
-                // recommencer une partie
-                liberer_serpent((partie_serpent*)jeu->premier_segment);  // librer la mmoire du serpent actuel
-                free(jeu);                   // librer la structure du jeu
-                jeu = initialiser_jeu();     // crer un nouveau jeu
+                // recommencer une partie dans la mme structure, sans rallouer le plateau
+                graine = graine_suivante();
+                reinitialiser_jeu(jeu, graine);
+                enregistrer_partie(prefixe_replay, jeu, graine);
                 jeu->en_menu = 0;        // ne pas retourner au menu
-                SetTargetFPS(10);            // rinitialiser la vitesse
-                PlaySound(son_background);   // redmarrer la musique
+                jeu->vitesse_normale = vitesse_normale;
+                jeu->vitesse_rapide = vitesse_rapide;
+                file.nombre = 0;             // oublier les directions en attente
+                anim.queue_a_bouge = 0;
+                accumulateur = 0;
+                noter_telemetrie(journal, telemetrie_debut_partie, 0, 0, jeu->score, jeu->longueur);
+                jouer_musique();             // la musique continue
             }
         }
         // jeu en cours
@@ -595,37 +1025,57 @@ int main() {
             if (IsKeyPressed(KEY_P)) {
                 jeu->en_pause = !jeu->en_pause;  // inverser l'tat de pause
             }
-
-            // gestion des contrles de direction
-            // on empche de faire demi-tour directement
-            if (IsKeyPressed(KEY_UP) && jeu->dir_actuelle != dir_bas) {
-                jeu->dir_actuelle = dir_haut;
-            }
-            if (IsKeyPressed(KEY_DOWN) && jeu->dir_actuelle != dir_haut) {
-                jeu->dir_actuelle = dir_bas;
+            if (IsKeyPressed(KEY_F5)) {
+                sauvegarder_jeu(jeu, chemin_sauvegarde);
             }
-            if (IsKeyPressed(KEY_LEFT) && jeu->dir_actuelle != dir_droite) {
-                jeu->dir_actuelle = dir_gauche;
-            }
-            if (IsKeyPressed(KEY_RIGHT) && jeu->dir_actuelle != dir_gauche) {
-                jeu->dir_actuelle = dir_droite;
+            if (IsKeyPressed(KEY_A) && pilote_auto != NULL) {
+                pilote_actif = !pilote_actif;    // le pilote prend ou rend la main
+                file.nombre = 0;
             }
 
+            // gestion des contrles de direction
+            // les flches sont mises en file et appliques une par pas
+            PROFIL_DEBUT(profil_entrees);
+            lire_entrees(&file, jeu);
+            PROFIL_FIN(profil_entrees);
+
             // dplacer le serpent si le jeu n'est pas en pause
             if (!jeu->en_pause) {
-                deplacer_serpent(jeu);
+                avancer_simulation(jeu, &file, &anim, &accumulateur, images_faussees > 0 ? 0.0 : GetFrameTime());
             }
         }
 
-        // afficher le jeu
-        dessiner_jeu(jeu);
+        // afficher le jeu; immobile, il n'est redessin que si l'image change,
+        // et la boucle attend les vnements au lieu de tourner  vide
+        // (sauf pour alimenter la musique, quelques fois par seconde)
+        int immobile = jeu_immobile(jeu);
+        int musique = musique_prete && IsMusicStreamPlaying(musique_fond);
+        attendre_evenements(immobile && !musique);
+        if (image_changee(jeu) || !immobile) {
+            dessiner_jeu(jeu, &anim);
+        } else {
+            PollInputEvents();
+            if (musique) {
+                WaitTime(duree_veille);
+            }
+        }
+        if (images_faussees > 0) images_faussees--;
+        PROFIL_FIN(profil_image);
     }
 
+#ifdef SNAKE_PROFIL
+    ecrire_profil("profil.txt"); // rsum des mesures
+#endif
+
     // nettoyage  la fin du jeu
-    liberer_serpent((partie_serpent*)jeu->premier_segment);  // librer la mmoire du serpent
-    free(jeu);                   // librer la structure du jeu
-    UnloadTexture(texture_fond); // dcharger la texture
-    decharger_sons();            // dcharger les sons
+    arreter_telemetrie(journal); // crire les derniers vnements
+    terminer_replay(replay, jeu); // partie interrompue: enregistre jusqu'ici
+    detruire_jeu(jeu);           // librer la structure du jeu
+    detruire_niveau(niv);        // puis le niveau qu'il utilisait
+    detruire_pilote(pilote_auto);
+    UnloadRenderTexture(texture_plateau);
+    UnloadRenderTexture(texture_hud);
+    decharger_ressources();      // dcharger l'image de fond et les sons
     CloseWindow();               // fermer la fentre
 
     return 0;
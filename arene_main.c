@@ -0,0 +1,133 @@
+// programme en ligne de commande: mesure le dbit de l'arne (ticks par seconde)
+// selon le nombre de serpents sur un mme plateau
+// les rsultats sont crits en CSV (une ligne par nombre de serpents)
+// compilation: gcc -O2 arene_main.c snake_arene.c snake_moteur.c -o arene
+#include "snake_arene.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour afficher l'aide
+void afficher_aide(const char* programme) {
+    printf("utilisation: %s [options] [serpents...]\n", programme);
+    printf("  -p LxH         taille du plateau (defaut 1000x1000)\n");
+    printf("  -s secondes    duree de chaque mesure (defaut 1)\n");
+    printf("  -g graine      graine de l'arene (defaut 1)\n");
+    printf("  -v ticks       verifie que deux arenes de meme graine restent identiques\n");
+    printf("  serpents       nombres de serpents mesures (defaut 100 300 1000 3000 10000)\n");
+}
+
+// fonction pour jouer des ticks avec la politique prudente; retourne l'empreinte finale
+uint64_t jouer_arene(arene* a, int32_t* actions, generateur* hasard, long long ticks) {
+    for (long long t = 0; t < ticks; t++) {
+        actions_prudentes(a, actions, hasard);
+        avancer_arene(a, actions);
+    }
+    return empreinte_arene(a);
+}
+
+// fonction pour mesurer une arne de nb_serpents serpents (une nourriture pour deux serpents)
+int mesurer_arene(int largeur, int hauteur, int nb_serpents, double duree, uint64_t graine) {
+    arene* a = creer_arene(largeur, hauteur, nb_serpents, nb_serpents / 2 + 1, graine);
+    int32_t* actions = (int32_t*)malloc(nb_serpents * sizeof(int32_t));
+    if (a == NULL || actions == NULL) {
+        printf("erreur: impossible de crer l'arne\n");
+        detruire_arene(a);
+        free(actions);
+        return 1;
+    }
+    generateur hasard;
+    initialiser_generateur(&hasard, graine ^ 0x9e3779b97f4a7c15ULL);
+
+    // laisser les serpents grandir un peu avant de mesurer
+    jouer_arene(a, actions, &hasard, 100);
+    a->ticks = 0;
+    a->secondes = 0;
+    a->pas_serpents = 0;
+    a->morts_mur = a->morts_serpent = a->morts_tete = 0;
+
+    double depart = horloge_secondes();
+    while (horloge_secondes() - depart < duree) {
+        jouer_arene(a, actions, &hasard, 10);
+    }
+
+    long long longueurs = 0;
+    for (int s = 0; s < nb_serpents; s++) {
+        longueurs += a->longueur[s];
+    }
+    long long morts = a->morts_mur + a->morts_serpent + a->morts_tete;
+    printf("%d,%dx%d,%lld,%.0f,%.0f,%.2f,%.3f,%.3f\n", nb_serpents, largeur, hauteur, a->ticks,
+           a->ticks / a->secondes, a->pas_serpents / a->secondes, (double)longueurs / nb_serpents,
+           (double)morts / a->ticks, (double)a->morts_tete / a->ticks);
+
+    detruire_arene(a);
+    free(actions);
+    return 0;
+}
+
+// fonction pour vrifier que la simulation ne dpend que de la graine
+int verifier_arene(int largeur, int hauteur, int nb_serpents, long long ticks, uint64_t graine) {
+    uint64_t empreintes[2];
+    for (int k = 0; k < 2; k++) {
+        arene* a = creer_arene(largeur, hauteur, nb_serpents, nb_serpents / 2 + 1, graine);
+        int32_t* actions = (int32_t*)malloc(nb_serpents * sizeof(int32_t));
+        if (a == NULL || actions == NULL) {
+            printf("erreur: impossible de crer l'arne\n");
+            detruire_arene(a);
+            free(actions);
+            return 1;
+        }
+        generateur hasard;
+        initialiser_generateur(&hasard, graine ^ 0x9e3779b97f4a7c15ULL);
+        empreintes[k] = jouer_arene(a, actions, &hasard, ticks);
+        detruire_arene(a);
+        free(actions);
+    }
+    printf("%d serpents, %lld ticks: empreintes %016llx %016llx %s\n", nb_serpents, ticks,
+           (unsigned long long)empreintes[0], (unsigned long long)empreintes[1],
+           empreintes[0] == empreintes[1] ? "identiques" : "DIFFERENTES");
+    return empreintes[0] != empreintes[1];
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    int largeur = 1000;
+    int hauteur = 1000;
+    double duree = 1.0;
+    uint64_t graine = 1;
+    long long ticks_verification = 0;
+    int nb_mesures = 0;
+    int serpents[64];
+
+    // lire les options
+    for (int i = 1; i < argc; i++) {
+        const char* valeur = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "-p") == 0 && valeur && sscanf(valeur, "%dx%d", &largeur, &hauteur) == 2) { i++; }
+        else if (strcmp(argv[i], "-s") == 0 && valeur) { duree = atof(valeur); i++; }
+        else if (strcmp(argv[i], "-g") == 0 && valeur) { graine = strtoull(valeur, NULL, 10); i++; }
+        else if (strcmp(argv[i], "-v") == 0 && valeur) { ticks_verification = atoll(valeur); i++; }
+        else if (argv[i][0] != '-' && atoi(argv[i]) > 0 && nb_mesures < 64) { serpents[nb_mesures++] = atoi(argv[i]); }
+        else {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+    }
+    if (nb_mesures == 0) {
+        int defaut[] = { 100, 300, 1000, 3000, 10000 };
+        for (int i = 0; i < 5; i++) serpents[nb_mesures++] = defaut[i];
+    }
+
+    int erreur = 0;
+    if (ticks_verification > 0) {
+        for (int i = 0; i < nb_mesures; i++) {
+            erreur |= verifier_arene(largeur, hauteur, serpents[i], ticks_verification, graine);
+        }
+        return erreur;
+    }
+
+    printf("serpents,plateau,ticks,ticks_par_seconde,pas_serpent_par_seconde,longueur_moyenne,morts_par_tick,tetes_par_tick\n");
+    for (int i = 0; i < nb_mesures; i++) {
+        erreur |= mesurer_arene(largeur, hauteur, serpents[i], duree, graine);
+    }
+    return erreur;
+}
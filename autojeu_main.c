@@ -0,0 +1,91 @@
+// programme en ligne de commande: joue des millions de parties sans fentre
+// et affiche le dbit et les statistiques
+// option -v: vrifie d'abord que le simulateur par lots donne exactement les parties
+// de deplacer_serpent (code de retour 1 sinon)
+// compilation: gcc -O3 -pthread autojeu_main.c snake_autojeu.c snake_lot.c snake_moteur.c -o autojeu
+#include "snake_autojeu.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour afficher l'aide
+void afficher_aide(const char* programme) {
+    printf("utilisation: %s [options]\n", programme);
+    printf("  -n parties     nombre de parties (defaut 1000000)\n");
+    printf("  -t fils        fils d'execution (defaut: un par coeur)\n");
+    printf("  -l largeur     parties jouees en meme temps par fil (defaut 256)\n");
+    printf("  -k parties     parties par tache (defaut: la largeur du lot)\n");
+    printf("  -m pas         pas maximum par partie (defaut 10000, 0 = sans limite)\n");
+    printf("  -g graine      graine de la premiere partie (defaut 1)\n");
+    printf("  -j politique   hasard ou gourmande (defaut gourmande)\n");
+    printf("  -v             comparer d'abord le lot au moteur (200 parties, 3000 pas)\n");
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    config_autojeu config = { 0 };
+    config.nb_parties = 1000000;
+    config.limite_pas = 10000;
+    config.graine = 1;
+    config.politique = politique_gourmande;
+    int verifier = 0;
+
+    // lire les options
+    for (int i = 1; i < argc; i++) {
+        const char* valeur = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "-j") == 0 && valeur) {
+            if (strcmp(valeur, "hasard") == 0) {
+                config.politique = politique_hasard;
+            } else if (strcmp(valeur, "gourmande") == 0) {
+                config.politique = politique_gourmande;
+            } else {
+                printf("erreur: politique inconnue: %s\n", valeur);
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-n") == 0 && valeur) { config.nb_parties = atoll(valeur); i++; }
+        else if (strcmp(argv[i], "-t") == 0 && valeur) { config.nb_fils = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-l") == 0 && valeur) { config.largeur_lot = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-k") == 0 && valeur) { config.parties_par_tache = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-m") == 0 && valeur) { config.limite_pas = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-g") == 0 && valeur) { config.graine = strtoull(valeur, NULL, 10); i++; }
+        else if (strcmp(argv[i], "-v") == 0) { verifier = 1; }
+        else {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+    }
+
+    // mmes graines et mmes actions pour le lot et pour deplacer_serpent
+    if (verifier) {
+        int differences = comparer_lot_moteur(200, 3000, config.graine);
+        printf("comparaison:    %d difference(s) entre le lot et le moteur\n", differences);
+        if (differences != 0) {
+            return 1;
+        }
+    }
+
+    resultats_autojeu* r = (resultats_autojeu*)malloc(sizeof(resultats_autojeu));
+    if (r == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour les rsultats\n");
+        return 1;
+    }
+
+    int erreur = lancer_autojeu(&config, r);
+    double parties = r->parties > 0 ? (double)r->parties : 1.0;
+
+    printf("parties:        %lld en %.2f s\n", r->parties, r->secondes);
+    printf("parties/s:      %.0f\n", r->parties / r->secondes);
+    printf("pas/s:          %.0f\n", r->pas / r->secondes);
+    printf("score moyen:    %.2f (median %d, p90 %d, p99 %d, max %d)\n",
+           r->somme_scores / parties, quantile_scores(r, 0.5), quantile_scores(r, 0.9),
+           quantile_scores(r, 0.99), r->score_max);
+    printf("longueur moyenne: %.2f\n", r->somme_longueurs / parties);
+    printf("morts: mur %lld (%.1f%%), serpent %lld (%.1f%%), limite de pas %lld\n",
+           r->morts_mur, 100.0 * r->morts_mur / parties,
+           r->morts_serpent, 100.0 * r->morts_serpent / parties, r->limites);
+
+    free(r);
+    return erreur;
+}
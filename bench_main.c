@@ -0,0 +1,362 @@
+// programme en ligne de commande: mesure le cot des fonctions du moteur
+// pour diffrentes longueurs de serpent, sans fentre ni son
+// et diffrentes tailles de plateau (de 30 x 20  2000 x 2000, ou -p largeurxhauteur)
+// les rsultats sont crits en CSV (une ligne par mesure) pour comparer deux versions
+// compilation: gcc -O2 bench_main.c snake_moteur.c -o bench
+#include "snake_moteur.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fentre du jeu (pour lire les mmes cases que dessiner_jeu): mme taille de case que Raylib_main.c
+#define taille_carre 20
+#define largeur_fenetre_max 1280
+#define hauteur_fenetre_max 800
+
+// plateau mesur (la hauteur doit tre paire pour que le circuit existe)
+int largeur;
+int hauteur;
+int nb_cases_plateau;
+
+// circuit passant une fois par chaque case: le serpent le suit sans jamais se mordre
+// (ligne 0 vers la droite, lignes suivantes en zigzag sans la colonne 0, retour par la colonne 0)
+position* circuit;
+direction* suivante;               // direction  prendre sur chaque case (y * largeur + x)
+
+double duree_mesure = 0.2;         // secondes de mesure par fonction (option -s)
+
+// fonction pour prparer le circuit d'un plateau
+// retourne 0 si tout s'est bien pass
+int preparer_circuit(int largeur_plateau, int hauteur_plateau) {
+    largeur = largeur_plateau;
+    hauteur = hauteur_plateau;
+    nb_cases_plateau = largeur * hauteur;
+    free(circuit);
+    free(suivante);
+    circuit = (position*)malloc(nb_cases_plateau * sizeof(position));
+    suivante = (direction*)malloc(nb_cases_plateau * sizeof(direction));
+    if (circuit == NULL || suivante == NULL) {
+        printf("erreur: impossible d'allouer le circuit\n");
+        return 1;
+    }
+
+    int k = 0;
+    for (int x = 0; x < largeur; x++) {
+        circuit[k++] = (position){ x, 0 };
+    }
+    for (int y = 1; y < hauteur; y++) {
+        for (int i = 1; i < largeur; i++) {
+            int x = y % 2 == 1 ? largeur - i : i;
+            circuit[k++] = (position){ x, y };
+        }
+    }
+    for (int y = hauteur - 1; y >= 1; y--) {
+        circuit[k++] = (position){ 0, y };
+    }
+
+    for (int i = 0; i < nb_cases_plateau; i++) {
+        position a = circuit[i];
+        position b = circuit[(i + 1) % nb_cases_plateau];
+        direction dir = b.x > a.x ? dir_droite : b.x < a.x ? dir_gauche : b.y > a.y ? dir_bas : dir_haut;
+        suivante[a.y * largeur + a.x] = dir;
+    }
+    return 0;
+}
+
+// fonction pour crer une partie dont le serpent occupe les longueur premires cases du circuit
+jeu_snake* construire_partie(int longueur, uint64_t graine) {
+    jeu_snake* jeu = creer_jeu(largeur, hauteur, graine);
+    if (jeu == NULL) return NULL;
+    if (reserver_corps(jeu, longueur) != 0) {
+        detruire_jeu(jeu);
+        return NULL;
+    }
+    jeu->en_menu = 0;
+
+    // vider le plateau
+    for (int i = 0; i < jeu->longueur; i++) {
+        position* segment = segment_serpent(jeu, i);
+        liberer_case(jeu, segment->x, segment->y);
+    }
+    if (jeu->nourriture.x >= 0) {
+        liberer_case(jeu, jeu->nourriture.x, jeu->nourriture.y);
+    }
+
+    // poser le serpent: la queue sur la case 0, la tte sur la case longueur - 1
+    for (int i = 0; i < longueur; i++) {
+        jeu->corps[i] = circuit[i];
+        occuper_case(jeu, circuit[i].x, circuit[i].y, case_serpent);
+    }
+    jeu->indice_queue = 0;
+    jeu->indice_tete = longueur - 1;
+    jeu->longueur = longueur;
+    jeu->croissance = 0;
+    jeu->dir_actuelle = suivante[circuit[longueur - 1].y * largeur + circuit[longueur - 1].x];
+
+    placer_nourriture(jeu);
+    return jeu;
+}
+
+// fonction pour crire une ligne de rsultats
+void ecrire_resultat(const char* mesure, int longueur, long long appels, double secondes) {
+    printf("%d,%d,%d,%s,%lld,%.2f\n", largeur, hauteur, longueur, mesure,
+           appels, appels > 0 ? secondes * 1e9 / appels : 0.0);
+}
+
+// mesure de deplacer_serpent: le serpent suit le circuit;
+// la partie est reconstruite (hors mesure) quand il a trop grandi
+// avec grandir, chaque pas est prcd d'un ajouter_segment
+void mesurer_deplacement(int longueur, int grandir) {
+    int croissance_max = longueur / 10 > 10000 ? longueur / 10 : 10000;
+    int limite = longueur + croissance_max < nb_cases_plateau - 1 ? longueur + croissance_max : nb_cases_plateau - 1;
+
+    long long appels = 0;
+    double secondes = 0;
+    uint64_t graine = 1;
+    double depart = horloge_secondes();
+
+    // sur les grands plateaux presque pleins, les reconstructions cotent plus cher
+    // que la mesure: s'arrter aussi aprs un temps total raisonnable
+    while (secondes < duree_mesure && horloge_secondes() - depart < 10 * duree_mesure) {
+        jeu_snake* jeu = construire_partie(longueur, graine++);
+        if (jeu == NULL) return;
+
+        long long pas = 0;
+        double debut = horloge_secondes();
+        while (pas < 100000 && jeu->longueur < limite && !jeu->game_over) {
+            position* tete = segment_serpent(jeu, 0);
+            jeu->dir_actuelle = suivante[tete->y * largeur + tete->x];
+            if (grandir) ajouter_segment(jeu);
+            deplacer_serpent(jeu);
+            pas++;
+        }
+        secondes += horloge_secondes() - debut;
+        appels += pas;
+        detruire_jeu(jeu);
+
+        if (pas == 0) break;  // serpent trop long pour avancer
+    }
+
+    ecrire_resultat(grandir ? "ajouter_segment+deplacer_serpent" : "deplacer_serpent", longueur, appels, secondes);
+}
+
+// mesure de est_sur_serpent sur des cases tires au hasard
+void mesurer_collision(int longueur) {
+    jeu_snake* jeu = construire_partie(longueur, 1);
+    if (jeu == NULL) return;
+
+    enum { nb_requetes = 4096 };
+    static position requetes[nb_requetes];
+    generateur hasard;
+    initialiser_generateur(&hasard, 7);
+    for (int i = 0; i < nb_requetes; i++) {
+        requetes[i].x = valeur_aleatoire(&hasard, 0, largeur - 1);
+        requetes[i].y = valeur_aleatoire(&hasard, 0, hauteur - 1);
+    }
+
+    long long appels = 0;
+    long long touches = 0;
+    double debut = horloge_secondes();
+    double secondes = 0;
+    while (secondes < duree_mesure) {
+        for (int i = 0; i < nb_requetes; i++) {
+            touches += est_sur_serpent(jeu, requetes[i].x, requetes[i].y);
+        }
+        appels += nb_requetes;
+        secondes = horloge_secondes() - debut;
+    }
+
+    if (touches < 0) printf("#\n");  // garder le rsultat pour que la boucle ne soit pas supprime
+    ecrire_resultat("est_sur_serpent", longueur, appels, secondes);
+    detruire_jeu(jeu);
+}
+
+// mesure de placer_nourriture: la nourriture est retire puis replace
+// (le cas le plus coteux de l'ancien tirage au hasard tait le plateau presque plein)
+void mesurer_nourriture(int longueur) {
+    jeu_snake* jeu = construire_partie(longueur, 1);
+    if (jeu == NULL) return;
+
+    long long appels = 0;
+    double debut = horloge_secondes();
+    double secondes = 0;
+    while (secondes < duree_mesure) {
+        for (int i = 0; i < 1000; i++) {
+            if (jeu->nourriture.x >= 0) {
+                liberer_case(jeu, jeu->nourriture.x, jeu->nourriture.y);
+            }
+            placer_nourriture(jeu);
+        }
+        appels += 1000;
+        secondes = horloge_secondes() - debut;
+    }
+
+    ecrire_resultat("placer_nourriture", longueur, appels, secondes);
+    detruire_jeu(jeu);
+}
+
+// mesure des fruits bonus: apparition, consommation et minuteurs
+void mesurer_bonus(int longueur) {
+    jeu_snake* jeu = construire_partie(longueur, 1);
+    if (jeu == NULL) return;
+
+    long long appels = 0;
+    double debut = horloge_secondes();
+    double secondes = 0;
+    while (secondes < duree_mesure) {
+        for (int i = 0; i < 1000; i++) {
+            jeu->nb_pas++;                       // les minuteurs se rglent sur le pas
+            mise_a_jour_fruits_bonus(jeu);
+            int k = placer_fruit_bonus(jeu);
+            if (k >= 0) {
+                position pos = jeu->fruits[k].pos;
+                consommer_fruit_bonus(jeu, k);
+                liberer_case(jeu, pos.x, pos.y);  // en jeu, la tte prendrait la case
+            }
+            jeu->croissance = 0;                 // le serpent ne grandit pas pendant la mesure
+        }
+        appels += 1000;
+        secondes = horloge_secondes() - debut;
+    }
+
+    ecrire_resultat("fruit_bonus", longueur, appels, secondes);
+    detruire_jeu(jeu);
+}
+
+// mesure de copier_jeu: une partie est recopie dans la mme destination
+// (une recherche qui explore plusieurs suites fait une copie par branche)
+// et de reinitialiser_jeu, qui recommence une partie dans la mme mmoire
+void mesurer_copie(int longueur) {
+    jeu_snake* jeu = construire_partie(longueur, 1);
+    jeu_snake* copie = jeu != NULL ? cloner_jeu(jeu) : NULL;
+    if (copie == NULL) {
+        detruire_jeu(jeu);
+        return;
+    }
+
+    long long appels = 0;
+    double debut = horloge_secondes();
+    double secondes = 0;
+    while (secondes < duree_mesure) {
+        for (int i = 0; i < 100; i++) {
+            copier_jeu(copie, jeu);
+        }
+        appels += 100;
+        secondes = horloge_secondes() - debut;
+    }
+    ecrire_resultat("copier_jeu", longueur, appels, secondes);
+
+    appels = 0;
+    debut = horloge_secondes();
+    secondes = 0;
+    while (secondes < duree_mesure) {
+        reinitialiser_jeu(copie, appels);
+        appels++;
+        secondes = horloge_secondes() - debut;
+    }
+    ecrire_resultat("reinitialiser_jeu", longueur, appels, secondes);
+
+    detruire_jeu(jeu);
+    detruire_jeu(copie);
+}
+
+// fonction pour lire les cases visibles autour de la tte, comme le fait dessiner_jeu
+// avant de dessiner (fentre de colonnes x lignes cases centre sur la tte)
+// ce n'est pas une mesure du dessin: seule la lecture du plateau est mesure,
+// sans raylib; le dessin lui-mme se mesure dans le jeu avec SNAKE_PROFIL
+// retourne le nombre de cases occupes vues
+int lire_cases_visibles(jeu_snake* jeu, int colonnes, int lignes) {
+    // fentre centre sur la tte, sans dpasser les bords du plateau
+    position* tete = segment_serpent(jeu, 0);
+    int x0 = tete->x - colonnes / 2;
+    int y0 = tete->y - lignes / 2;
+    if (x0 > largeur - colonnes) x0 = largeur - colonnes;
+    if (y0 > hauteur - lignes) y0 = hauteur - lignes;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+
+    int occupees = 0;
+    for (int y = 0; y < lignes; y++) {
+        for (int x = 0; x < colonnes; x++) {
+            occupees += lire_case(jeu, x0 + x, y0 + y) != case_vide;
+        }
+    }
+    return occupees;
+}
+
+// mesure de la lecture des cases d'une fentre de la taille de celle du jeu
+void mesurer_lecture_visible(int longueur) {
+    int colonnes = largeur * taille_carre < largeur_fenetre_max ? largeur : largeur_fenetre_max / taille_carre;
+    int lignes = hauteur * taille_carre < hauteur_fenetre_max ? hauteur : hauteur_fenetre_max / taille_carre;
+
+    jeu_snake* jeu = construire_partie(longueur, 1);
+    if (jeu == NULL) {
+        return;
+    }
+
+    long long appels = 0;
+    long long occupees = 0;
+    double debut = horloge_secondes();
+    double secondes = 0;
+    while (secondes < duree_mesure) {
+        occupees += lire_cases_visibles(jeu, colonnes, lignes);
+        appels++;
+        secondes = horloge_secondes() - debut;
+    }
+
+    ecrire_resultat("lecture_cases_visibles", longueur, appels, secondes);
+    if (occupees < 0) printf("#\n");  // garder le rsultat pour que la boucle ne soit pas supprime
+    detruire_jeu(jeu);
+}
+
+// fonction pour mesurer toutes les fonctions sur un plateau
+void mesurer_plateau(int largeur_plateau, int hauteur_plateau) {
+    if (preparer_circuit(largeur_plateau, hauteur_plateau) != 0) return;
+
+    // longueurs mesures: de 3 cases au plateau presque plein
+    int n = nb_cases_plateau;
+    int longueurs[] = { 3, n / 100, n / 10, n / 2, n * 9 / 10, n - 2 };
+    int nb_longueurs = sizeof(longueurs) / sizeof(longueurs[0]);
+
+    for (int i = 0; i < nb_longueurs; i++) {
+        int longueur = longueurs[i];
+        if (longueur < 3 || (i > 0 && longueur <= longueurs[i - 1])) continue;
+
+        mesurer_deplacement(longueur, 0);
+        mesurer_deplacement(longueur, 1);
+        mesurer_collision(longueur);
+        mesurer_nourriture(longueur);
+        mesurer_bonus(longueur);
+        mesurer_copie(longueur);
+        mesurer_lecture_visible(longueur);
+        fflush(stdout);
+    }
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    // plateaux mesurs par dfaut
+    int plateaux[][2] = { { largeur_jeu, hauteur_jeu }, { 300, 200 }, { 1000, 1000 }, { 2000, 2000 } };
+    int nb_plateaux = sizeof(plateaux) / sizeof(plateaux[0]);
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-s") == 0) duree_mesure = atof(argv[i + 1]);
+        if (strcmp(argv[i], "-p") == 0) {
+            if (sscanf(argv[i + 1], "%dx%d", &plateaux[0][0], &plateaux[0][1]) != 2 ||
+                plateaux[0][0] < 5 || plateaux[0][1] < 2 || plateaux[0][1] % 2 != 0) {
+                printf("erreur: plateau invalide: %s (largeurxhauteur, hauteur paire)\n", argv[i + 1]);
+                return 1;
+            }
+            nb_plateaux = 1;
+        }
+    }
+
+    printf("largeur,hauteur,longueur,mesure,appels,ns_par_appel\n");
+    for (int i = 0; i < nb_plateaux; i++) {
+        mesurer_plateau(plateaux[i][0], plateaux[i][1]);
+    }
+
+    free(circuit);
+    free(suivante);
+    return 0;
+}
@@ -0,0 +1,112 @@
+// programme en ligne de commande: mesure le dbit de l'environnement d'apprentissage
+// (pas d'environnement par seconde, observations comprises) et le compare au lot seul
+// option -v: vrifie aprs chaque pas que les observations mises  jour case par case
+// sont identiques  une rcriture complte
+// compilation: gcc -O3 env_main.c snake_env.c snake_lot.c snake_moteur.c -o env
+#include "snake_env.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour afficher l'aide
+void afficher_aide(const char* programme) {
+    printf("utilisation: %s [options]\n", programme);
+    printf("  -n parties     parties jouees en meme temps (defaut 256)\n");
+    printf("  -p pas         pas d'environnement a jouer (defaut 10000)\n");
+    printf("  -m pas         pas maximum par partie (defaut 1000, 0 = sans limite)\n");
+    printf("  -g graine      graine de la premiere partie (defaut 1)\n");
+    printf("  -v             verifier les observations apres chaque pas\n");
+}
+
+// fonction pour tirer une action au hasard pour chaque partie (une sur deux garde la direction)
+void tirer_actions(int32_t* actions, int nb_parties, generateur* hasard) {
+    for (int i = 0; i < nb_parties; i++) {
+        int tirage = valeur_aleatoire(hasard, 0, 7);
+        actions[i] = tirage < 4 ? tirage : -1;
+    }
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    int nb_parties = 256;
+    int nb_pas = 10000;
+    int limite_pas = 1000;
+    uint64_t graine = 1;
+    int verifier = 0;
+
+    // lire les options
+    for (int i = 1; i < argc; i++) {
+        const char* valeur = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "-n") == 0 && valeur) { nb_parties = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-p") == 0 && valeur) { nb_pas = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-m") == 0 && valeur) { limite_pas = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-g") == 0 && valeur) { graine = strtoull(valeur, NULL, 10); i++; }
+        else if (strcmp(argv[i], "-v") == 0) { verifier = 1; }
+        else {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+    }
+    if (nb_parties <= 0) {
+        printf("erreur: nombre de parties invalide: %d\n", nb_parties);
+        return 1;
+    }
+
+    // tableaux de l'appelant: l'environnement crit dedans sans rien allouer pendant les pas
+    size_t n = (size_t)nb_parties;
+    uint8_t* observations = (uint8_t*)malloc(n * taille_observation_env);
+    float* recompenses = (float*)malloc(n * sizeof(float));
+    uint8_t* terminees = (uint8_t*)malloc(n);
+    int32_t* actions = (int32_t*)malloc(n * sizeof(int32_t));
+    env_snake* env = creer_env(nb_parties, limite_pas);
+    lot_snake* lot = creer_lot(nb_parties, graine);
+    if (observations == NULL || recompenses == NULL || terminees == NULL || actions == NULL || env == NULL || lot == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire\n");
+        return 1;
+    }
+
+    attacher_env(env, observations, recompenses, terminees);
+    reinitialiser_env(env, graine);
+
+    // l'environnement, avec les mmes actions que le lot seul
+    generateur hasard;
+    initialiser_generateur(&hasard, graine);
+    long long parties = 0;
+    long long mauvaises = 0;
+    double somme_recompenses = 0.0;
+    for (int pas = 0; pas < nb_pas; pas++) {
+        tirer_actions(actions, nb_parties, &hasard);
+        avancer_env(env, actions);
+        for (int i = 0; i < nb_parties; i++) {
+            somme_recompenses += recompenses[i];
+            parties += terminees[i] != fin_aucune;
+        }
+        if (verifier) {
+            mauvaises += verifier_observations_env(env);
+        }
+    }
+
+    initialiser_generateur(&hasard, graine);
+    for (int pas = 0; pas < nb_pas; pas++) {
+        tirer_actions(actions, nb_parties, &hasard);
+        avancer_lot(lot, actions);
+    }
+
+    printf("parties:        %d en parallele, %d pas, %zu octets d'observation par partie\n",
+           nb_parties, nb_pas, (size_t)taille_observation_env);
+    printf("pas env/s:      %.0f (%.2f s)\n", debit_env(env), env->secondes);
+    printf("pas lot/s:      %.0f (%.2f s, sans observations)\n", debit_lot(lot), lot->secondes);
+    printf("parties finies: %lld, recompense moyenne par partie %.3f\n",
+           parties, parties > 0 ? somme_recompenses / parties : 0.0);
+    if (verifier) {
+        printf("observations:   %lld pas de partie differents de la reecriture complete\n", mauvaises);
+    }
+
+    detruire_lot(lot);
+    detruire_env(env);
+    free(observations);
+    free(recompenses);
+    free(terminees);
+    free(actions);
+    return mauvaises != 0;
+}
@@ -0,0 +1,127 @@
+// programme en ligne de commande: fabrique le paquet de ressources du jeu
+// les fichiers gardent le nom donn sur la ligne de commande (lancer depuis le dossier des ressources):
+//   paquet ressources.pak background.png manger.wav bonus.wav vitesse.wav game_over.wav
+// avec -c, crit aussi un fichier C  compiler avec le jeu (option -DSNAKE_PAQUET_INTEGRE)
+// compilation: gcc -O2 paquet_main.c -o paquet
+#include "snake_paquet.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour afficher l'aide
+void afficher_aide(const char* programme) {
+    printf("utilisation: %s sortie.pak [-c paquet_integre.c] fichier...\n", programme);
+}
+
+// fonction pour lire un fichier entier; retourne NULL si impossible
+unsigned char* lire_fichier(const char* chemin, uint32_t* taille) {
+    FILE* fichier = fopen(chemin, "rb");
+    if (fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return NULL;
+    }
+    fseek(fichier, 0, SEEK_END);
+    long longueur = ftell(fichier);
+    fseek(fichier, 0, SEEK_SET);
+
+    unsigned char* octets = (unsigned char*)malloc(longueur > 0 ? longueur : 1);
+    if (octets == NULL || fread(octets, 1, longueur, fichier) != (size_t)longueur) {
+        printf("erreur: impossible de lire %s\n", chemin);
+        free(octets);
+        fclose(fichier);
+        return NULL;
+    }
+    fclose(fichier);
+    *taille = (uint32_t)longueur;
+    return octets;
+}
+
+// fonction pour crire le paquet sous forme de tableau C
+int ecrire_source(const char* chemin, const unsigned char* octets, size_t taille) {
+    FILE* fichier = fopen(chemin, "w");
+    if (fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return 1;
+    }
+
+    fprintf(fichier, "// fichier produit par paquet_main.c: ressources intgres au programme\n");
+    fprintf(fichier, "#include <stddef.h>\n\n");
+    fprintf(fichier, "_Alignas(%d) const unsigned char paquet_integre[] = {", alignement_paquet);
+    for (size_t i = 0; i < taille; i++) {
+        fprintf(fichier, i % 16 == 0 ? "\n    %u," : " %u,", octets[i]);
+    }
+    fprintf(fichier, "\n};\nconst size_t taille_paquet_integre = %zu;\n", taille);
+    return fclose(fichier) != 0;
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        afficher_aide(argv[0]);
+        return 1;
+    }
+    const char* sortie = argv[1];
+    const char* source = NULL;
+    int premier = 2;
+    if (strcmp(argv[2], "-c") == 0) {
+        if (argc < 5) {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+        source = argv[3];
+        premier = 4;
+    }
+    int nb_entrees = argc - premier;
+
+    // lire les fichiers et calculer leur place dans le paquet
+    entree_paquet* entrees = (entree_paquet*)calloc(nb_entrees, sizeof(entree_paquet));
+    unsigned char** donnees = (unsigned char**)calloc(nb_entrees, sizeof(unsigned char*));
+    if (entrees == NULL || donnees == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire\n");
+        return 1;
+    }
+    size_t taille = sizeof(entete_paquet) + nb_entrees * sizeof(entree_paquet);
+    for (int i = 0; i < nb_entrees; i++) {
+        const char* nom = argv[premier + i];
+        if (strlen(nom) >= taille_nom_paquet) {
+            printf("erreur: nom trop long: %s\n", nom);
+            return 1;
+        }
+        donnees[i] = lire_fichier(nom, &entrees[i].taille);
+        if (donnees[i] == NULL) {
+            return 1;
+        }
+        strcpy(entrees[i].nom, nom);
+        taille = (taille + alignement_paquet - 1) / alignement_paquet * alignement_paquet;
+        entrees[i].decalage = (uint32_t)taille;
+        taille += entrees[i].taille;
+    }
+
+    // assembler le paquet en mmoire
+    unsigned char* paquet_complet = (unsigned char*)calloc(1, taille);
+    if (paquet_complet == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire\n");
+        return 1;
+    }
+    entete_paquet entete = { magie_paquet, (uint32_t)nb_entrees };
+    memcpy(paquet_complet, &entete, sizeof(entete));
+    memcpy(paquet_complet + sizeof(entete), entrees, nb_entrees * sizeof(entree_paquet));
+    for (int i = 0; i < nb_entrees; i++) {
+        memcpy(paquet_complet + entrees[i].decalage, donnees[i], entrees[i].taille);
+        printf("%-40s %10u octets\n", entrees[i].nom, entrees[i].taille);
+        free(donnees[i]);
+    }
+
+    FILE* fichier = fopen(sortie, "wb");
+    if (fichier == NULL || fwrite(paquet_complet, 1, taille, fichier) != taille || fclose(fichier) != 0) {
+        printf("erreur: impossible d'crire %s\n", sortie);
+        return 1;
+    }
+    printf("%s: %d ressources, %zu octets\n", sortie, nb_entrees, taille);
+
+    int erreur = source != NULL ? ecrire_source(source, paquet_complet, taille) : 0;
+    free(paquet_complet);
+    free(entrees);
+    free(donnees);
+    return erreur;
+}
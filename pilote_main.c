@@ -0,0 +1,153 @@
+// programme en ligne de commande: fait jouer le pilote automatique sans fentre
+// (parties d'endurance, politique de rfrence) et affiche le dbit
+// et le temps de dcision du pilote
+// vrifie aussi qu'une fois la partie rserve (reserver_jeu), jouer et recommencer
+// des milliers de parties ne font aucune allocation (code de retour 2 sinon)
+// option -c: parties sur un niveau lu dans une carte (voir snake_niveau.h)
+// compilation: gcc -O2 pilote_main.c snake_pilote.c snake_niveau.c snake_moteur.c -o pilote
+#include "snake_pilote.h"
+#include "snake_niveau.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define nb_tranches_latence 32     // tranche k: dcisions de 2^k  2^(k+1) nanosecondes
+
+// fonction pour afficher l'aide
+void afficher_aide(const char* programme) {
+    printf("utilisation: %s [options]\n", programme);
+    printf("  -n parties     nombre de parties (defaut 100)\n");
+    printf("  -m pas         pas maximum par partie (defaut 100000, 0 = sans limite)\n");
+    printf("  -g graine      graine de la premiere partie (defaut 1)\n");
+    printf("  -p LxH         taille du plateau (defaut %dx%d)\n", largeur_jeu, hauteur_jeu);
+    printf("  -c carte       niveau a charger (donne aussi la taille du plateau)\n");
+}
+
+// fonction pour trouver la dure sous laquelle se trouve une fraction des dcisions
+// (borne haute de la tranche, en microsecondes)
+double quantile_latence(const long long* tranches, long long total, double fraction) {
+    long long cible = (long long)(fraction * total);
+    long long cumul = 0;
+    for (int k = 0; k < nb_tranches_latence; k++) {
+        cumul += tranches[k];
+        if (cumul > cible) {
+            return (double)(2ULL << k) / 1000.0;
+        }
+    }
+    return (double)(2ULL << (nb_tranches_latence - 1)) / 1000.0;
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    long long nb_parties = 100;
+    int limite_pas = 100000;
+    uint64_t graine = 1;
+    int largeur = largeur_jeu;
+    int hauteur = hauteur_jeu;
+    const char* chemin_niveau = NULL;
+
+    // lire les options
+    for (int i = 1; i < argc; i++) {
+        const char* valeur = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "-n") == 0 && valeur) { nb_parties = atoll(valeur); i++; }
+        else if (strcmp(argv[i], "-m") == 0 && valeur) { limite_pas = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-g") == 0 && valeur) { graine = strtoull(valeur, NULL, 10); i++; }
+        else if (strcmp(argv[i], "-p") == 0 && valeur && sscanf(valeur, "%dx%d", &largeur, &hauteur) == 2) { i++; }
+        else if (strcmp(argv[i], "-c") == 0 && valeur) { chemin_niveau = valeur; i++; }
+        else {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+    }
+
+    niveau* niv = NULL;
+    if (chemin_niveau != NULL) {
+        niv = charger_niveau(chemin_niveau);
+        if (niv == NULL) {
+            return 1;
+        }
+        largeur = niv->largeur;
+        hauteur = niv->hauteur;
+    }
+
+    jeu_snake* jeu = creer_jeu(largeur, hauteur, graine);
+    pilote* p = creer_pilote(largeur, hauteur);
+    if (jeu == NULL || p == NULL || choisir_niveau(jeu, niv) != 0 || reserver_jeu(jeu) != 0) {
+        return 1;
+    }
+    long long allocations_depart = allocations_moteur();
+
+    long long tranches[nb_tranches_latence] = { 0 };
+    long long pas = 0;
+    long long somme_scores = 0;
+    long long somme_longueurs = 0;
+    long long morts_mur = 0, morts_serpent = 0, limites = 0, remplis = 0;
+    int score_max = 0;
+    double decision_max = 0;
+    double temps_decisions = 0;
+    double depart = horloge_secondes();
+
+    for (long long partie = 0; partie < nb_parties; partie++) {
+        reinitialiser_jeu(jeu, graine + partie);
+        jeu->en_menu = 0;
+
+        int evenements = 0;
+        while (!jeu->game_over && (limite_pas == 0 || jeu->nb_pas < limite_pas)) {
+            double avant = horloge_secondes();
+            direction dir = choisir_direction(p, jeu);
+            double duree = horloge_secondes() - avant;
+
+            long long nanosecondes = (long long)(duree * 1e9);
+            int k = 0;
+            while (k < nb_tranches_latence - 1 && nanosecondes >= (2LL << k)) k++;
+            tranches[k]++;
+            temps_decisions += duree;
+            if (duree > decision_max) decision_max = duree;
+
+            jeu->dir_actuelle = dir;
+            evenements = deplacer_serpent(jeu);
+            // plateau plein: plus de nourriture  placer, la partie est gagne
+            if (jeu->nourriture.x < 0 && !jeu->game_over) {
+                remplis++;
+                break;
+            }
+        }
+
+        pas += jeu->nb_pas;
+        somme_scores += jeu->score;
+        somme_longueurs += jeu->longueur;
+        if (jeu->score > score_max) score_max = jeu->score;
+        if (evenements & evenement_mort_mur) morts_mur++;
+        else if (evenements & evenement_mort_serpent) morts_serpent++;
+        else if (jeu->nourriture.x >= 0) limites++;
+    }
+    double secondes = horloge_secondes() - depart;
+    long long allocations = allocations_moteur() - allocations_depart;
+    double parties = nb_parties > 0 ? (double)nb_parties : 1.0;
+    long long decisions = p->decisions > 0 ? p->decisions : 1;
+
+    printf("plateau:        %dx%d\n", largeur, hauteur);
+    if (niv != NULL) {
+        printf("niveau:         %s, %d murs, %d cases praticables%s\n", chemin_niveau, niv->nb_murs,
+               niv->nb_praticables, niv->distances != NULL ? "" : " (sans table des distances)");
+    }
+    printf("parties:        %lld en %.2f s\n", nb_parties, secondes);
+    printf("pas/s:          %.0f\n", pas / secondes);
+    printf("score moyen:    %.2f (max %d)\n", somme_scores / parties, score_max);
+    printf("longueur moyenne: %.2f sur %d cases\n", somme_longueurs / parties,
+           niv != NULL ? niv->nb_praticables : largeur * hauteur);
+    printf("fins: plateau rempli %lld, mur %lld, serpent %lld, limite de pas %lld\n",
+           remplis, morts_mur, morts_serpent, limites);
+    printf("decisions:      %lld (chemins calcules %lld, reutilises %lld, secours %lld, impasses %lld)\n",
+           p->decisions, p->plans, p->reutilisations, p->secours, p->impasses);
+    printf("latence (us):   moyenne %.2f, p50 < %.2f, p99 < %.2f, p99.9 < %.2f, max %.2f\n",
+           temps_decisions * 1e6 / decisions,
+           quantile_latence(tranches, p->decisions, 0.5), quantile_latence(tranches, p->decisions, 0.99),
+           quantile_latence(tranches, p->decisions, 0.999), decision_max * 1e6);
+    printf("allocations:    %lld pendant les parties%s\n", allocations, allocations == 0 ? "" : " (ERREUR: 0 attendu)");
+
+    detruire_pilote(p);
+    detruire_jeu(jeu);
+    detruire_niveau(niv);
+    return allocations == 0 ? 0 : 2;
+}
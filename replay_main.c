@@ -0,0 +1,168 @@
+// programme en ligne de commande: relit un enregistrement de partie sans fentre
+// sans option, rejoue toute la partie aussi vite que possible et vrifie le score final;
+// avec -a pas, reprend la partie juste avant ce pas depuis l'image la plus proche
+// compilation: gcc -O2 replay_main.c snake_replay.c snake_sauvegarde.c snake_niveau.c snake_moteur.c -o replay
+#include "snake_replay.h"
+#include "snake_niveau.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour afficher l'aide
+void afficher_aide(const char* programme) {
+    printf("utilisation: %s fichier.replay [options]\n", programme);
+    printf("  -a pas         afficher l'etat de la partie juste avant ce pas\n");
+    printf("  -c             comparer aussi chaque image a la partie rejouee\n");
+    printf("  -e graine      enregistrer d'abord une partie jouee automatiquement dans le fichier\n");
+    printf("  -p LxH         plateau de la partie enregistree avec -e (defaut 30x20)\n");
+    printf("  -n carte       niveau de la partie enregistree avec -e (donne aussi le plateau)\n");
+}
+
+// fonction pour choisir une direction vers la nourriture sans se cogner
+static direction direction_gourmande(jeu_snake* jeu) {
+    position tete = *segment_serpent(jeu, 0);
+    direction preferees[4];
+    int nombre = 0;
+
+    if (jeu->nourriture.x < tete.x) preferees[nombre++] = dir_gauche;
+    if (jeu->nourriture.x > tete.x) preferees[nombre++] = dir_droite;
+    if (jeu->nourriture.y < tete.y) preferees[nombre++] = dir_haut;
+    if (jeu->nourriture.y > tete.y) preferees[nombre++] = dir_bas;
+    preferees[nombre++] = jeu->dir_actuelle;
+
+    for (int essai = 0; essai < nombre + 4; essai++) {
+        direction dir = essai < nombre ? preferees[essai] : (direction)(essai - nombre);
+        int x = tete.x + (dir == dir_droite) - (dir == dir_gauche);
+        int y = tete.y + (dir == dir_bas) - (dir == dir_haut);
+        if (x >= 0 && x < jeu->largeur && y >= 0 && y < jeu->hauteur && !est_sur_serpent(jeu, x, y) &&
+            lire_case(jeu, x, y) != case_mur) {
+            return dir;
+        }
+    }
+    return jeu->dir_actuelle;
+}
+
+// fonction pour enregistrer une partie joue automatiquement
+// (sur un niveau, comme le jeu: les murs sont poss par reinitialiser_jeu)
+int enregistrer_demo(const char* chemin, int largeur, int hauteur, const niveau* niv, uint64_t graine) {
+    jeu_snake* jeu = creer_jeu(largeur, hauteur, graine);
+    if (jeu == NULL) {
+        return 1;
+    }
+    if (niv != NULL) {
+        if (choisir_niveau(jeu, niv) != 0) {
+            detruire_jeu(jeu);
+            return 1;
+        }
+        reinitialiser_jeu(jeu, graine);
+    }
+    jeu->en_menu = 0;
+
+    enregistreur_replay* rec = commencer_replay(chemin, jeu, graine, intervalle_images_defaut);
+    if (rec == NULL) {
+        detruire_jeu(jeu);
+        return 1;
+    }
+    while (!jeu->game_over && jeu->nb_pas < 1000000) {
+        jeu->dir_actuelle = direction_gourmande(jeu);
+        noter_pas_replay(rec, jeu);
+        deplacer_serpent(jeu);
+    }
+    printf("partie enregistree: %d pas, score %d\n", jeu->nb_pas, jeu->score);
+    terminer_replay(rec, jeu);
+    detruire_jeu(jeu);
+    return 0;
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        afficher_aide(argv[0]);
+        return 1;
+    }
+    const char* chemin = argv[1];
+    int pas = -1;
+    int demo = 0;
+    int comparer_images = 0;
+    uint64_t graine = 0;
+    int largeur = largeur_jeu;
+    int hauteur = hauteur_jeu;
+    const char* chemin_niveau = NULL;
+
+    // lire les options
+    for (int i = 2; i < argc; i++) {
+        const char* valeur = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "-a") == 0 && valeur) { pas = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-c") == 0) comparer_images = 1;
+        else if (strcmp(argv[i], "-e") == 0 && valeur) { demo = 1; graine = strtoull(valeur, NULL, 10); i++; }
+        else if (strcmp(argv[i], "-p") == 0 && valeur && sscanf(valeur, "%dx%d", &largeur, &hauteur) == 2) { i++; }
+        else if (strcmp(argv[i], "-n") == 0 && valeur) { chemin_niveau = valeur; i++; }
+        else {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+    }
+
+    if (demo) {
+        niveau* niv = NULL;
+        if (chemin_niveau != NULL) {
+            niv = charger_niveau(chemin_niveau);
+            if (niv == NULL) {
+                return 1;
+            }
+            largeur = niv->largeur;
+            hauteur = niv->hauteur;
+        }
+        int erreur = enregistrer_demo(chemin, largeur, hauteur, niv, graine);
+        detruire_niveau(niv);
+        if (erreur != 0) {
+            return 1;
+        }
+    }
+
+    lecteur_replay* lec = ouvrir_replay(chemin);
+    if (lec == NULL) {
+        return 1;
+    }
+    printf("plateau:        %d x %d, graine %llu\n", lec->entete.largeur, lec->entete.hauteur,
+           (unsigned long long)lec->entete.graine);
+    printf("images:         %d (une tous les %d pas)\n", lec->nb_images, lec->entete.intervalle_images);
+    if (lec->niveau != NULL) {
+        printf("niveau:         %d murs\n", lec->niveau->nb_murs);
+    }
+    if (lec->pas_final >= 0) {
+        printf("fin:            pas %d, score %d\n", lec->pas_final, lec->score_final);
+    } else {
+        printf("fin:            partie interrompue\n");
+    }
+
+    int erreur = 0;
+    if (pas >= 0) {
+        // reprendre la partie au pas demand
+        double debut = horloge_secondes();
+        jeu_snake* jeu = aller_au_pas(lec, pas);
+        double secondes = horloge_secondes() - debut;
+        if (jeu == NULL) {
+            printf("erreur: le pas %d n'est pas dans l'enregistrement\n", pas);
+            erreur = 1;
+        } else {
+            position tete = *segment_serpent(jeu, 0);
+            printf("pas:            %d, atteint en %.3f ms\n", jeu->nb_pas, secondes * 1000);
+            printf("score:          %d, longueur %d\n", jeu->score, jeu->longueur);
+            printf("tete:           (%d, %d), direction %d\n", tete.x, tete.y, jeu->dir_actuelle);
+            printf("nourriture:     (%d, %d)\n", jeu->nourriture.x, jeu->nourriture.y);
+            detruire_jeu(jeu);
+        }
+    } else {
+        // rejouer toute la partie et comparer le score
+        int score = 0;
+        double secondes = 0;
+        erreur = verifier_replay(lec, comparer_images, &score, &secondes);
+        printf("verification:   %s, score rejoue %d en %.3f s (%.0f pas/s)\n",
+               erreur == 0 ? "ok" : "echec", score, secondes,
+               secondes > 0 ? lec->pas_final / secondes : 0.0);
+    }
+
+    fermer_replay(lec);
+    return erreur;
+}
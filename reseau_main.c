@@ -0,0 +1,227 @@
+// programme en ligne de commande: parties  plusieurs en rseau, joues par le pilote automatique
+// sans option -u, tous les joueurs tournent dans ce programme et se parlent par une boucle
+// locale (latence, gigue et pertes rglables);  la fin, les plateaux de tous les joueurs
+// doivent tre identiques. avec -u, un seul joueur joue en UDP contre les autres machines
+// affiche les mesures de la session: retours en arrire, profondeur et temps de rejeu
+// compilation: gcc -O2 reseau_main.c snake_reseau.c snake_pilote.c snake_moteur.c -o reseau
+// (sous windows, ajouter -lws2_32)
+#include "snake_reseau.h"
+#include "snake_pilote.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// un joueur: sa session et son pilote
+// le pilote dcide sur une copie de son plateau en avance de delai pas: ses entres
+// sont joues delai pas plus tard, et son plateau ne dpend que de ses propres entres
+typedef struct {
+    session_reseau* session;
+    pilote* pilote;
+    jeu_snake* en_avance;
+} joueur_reseau;
+
+// fonction pour afficher l'aide
+void afficher_aide(const char* programme) {
+    printf("utilisation: %s [options]\n", programme);
+    printf("  -n joueurs     nombre de joueurs (defaut 2, au plus %d)\n", nb_joueurs_max);
+    printf("  -d pas         delai des entrees locales (defaut 2)\n");
+    printf("  -m pas         pas joues au plus (defaut 5000)\n");
+    printf("  -p LxH         taille du plateau (defaut %dx%d)\n", largeur_jeu, hauteur_jeu);
+    printf("  -g graine      graine de la partie (defaut 1)\n");
+    printf("boucle locale:\n");
+    printf("  -l images      latence (defaut 4)\n");
+    printf("  -x images      gigue en plus de la latence (defaut 3)\n");
+    printf("  -e pour_mille  messages perdus (defaut 50)\n");
+    printf("udp:\n");
+    printf("  -u joueur hote:port...   numero de ce joueur, puis l'adresse de chaque joueur\n");
+    printf("  -f images/s    cadence (defaut 60)\n");
+}
+
+// fonction pour prparer un joueur
+int preparer_joueur(joueur_reseau* j, session_reseau* session) {
+    j->session = session;
+    j->pilote = creer_pilote(session->jeux[0]->largeur, session->jeux[0]->hauteur);
+    j->en_avance = cloner_jeu(session->jeux[session->local]);
+    if (j->pilote == NULL || j->en_avance == NULL) {
+        return 1;
+    }
+    // les delai premiers pas sont jous sans entre
+    for (int k = 0; k < session->delai; k++) {
+        deplacer_serpent(j->en_avance);
+    }
+    return 0;
+}
+
+// fonction pour jouer une image d'un joueur
+void jouer_image(joueur_reseau* j) {
+    int action = j->en_avance->game_over ? -1 : (int)choisir_direction(j->pilote, j->en_avance);
+    if (avancer_session(j->session, action)) {
+        if (action >= 0) j->en_avance->dir_actuelle = (direction)action;
+        deplacer_serpent(j->en_avance);
+    }
+}
+
+// fonction pour afficher les mesures d'un joueur
+void afficher_mesures(int numero, const session_reseau* s) {
+    const mesures_reseau* m = &s->mesures;
+    long long retours = m->retours > 0 ? m->retours : 1;
+    printf("joueur %d: %lld pas, %lld attentes, %lld predictions fausses, %lld messages envoyes, %lld recus\n",
+           numero, m->pas, m->attentes, m->predictions_fausses, m->messages_envoyes, m->messages_recus);
+    printf("  retours en arriere: %lld, %lld pas rejoues (moyenne %.1f, max %d)\n",
+           m->retours, m->pas_rejoues, (double)m->pas_rejoues / retours, m->profondeur_max);
+    printf("  temps de rejeu: moyenne %.2f us, max %.2f us, total %.3f ms\n",
+           m->secondes_rejeu * 1e6 / retours, m->rejeu_max * 1e6, m->secondes_rejeu * 1e3);
+    for (int k = 0; k < s->nb_joueurs; k++) {
+        printf("  plateau %d: score %d, longueur %d%s\n", k, s->jeux[k]->score, s->jeux[k]->longueur,
+               s->jeux[k]->game_over ? " (fini)" : "");
+    }
+}
+
+// fonction pour faire jouer tous les joueurs dans ce programme par une boucle locale
+int jouer_boucle_locale(int nb_joueurs, int delai, int limite, int largeur, int hauteur, uint64_t graine,
+                        int latence, int gigue, int pertes) {
+    boucle_locale* boucle = creer_boucle_locale(nb_joueurs, latence, gigue, pertes, graine);
+    joueur_reseau joueurs[nb_joueurs_max];
+    memset(joueurs, 0, sizeof(joueurs));
+    if (boucle == NULL) return 1;
+    for (int i = 0; i < nb_joueurs; i++) {
+        session_reseau* s = creer_session(nb_joueurs, i, delai, largeur, hauteur, graine, transport_boucle(boucle, i));
+        if (s == NULL || preparer_joueur(&joueurs[i], s) != 0) return 1;
+    }
+
+    // jouer jusqu' la limite, puis changer les dernires entres
+    double depart = horloge_secondes();
+    long long images = 0;
+    for (;;) {
+        int confirmes = 0;
+        for (int i = 0; i < nb_joueurs; i++) {
+            session_reseau* s = joueurs[i].session;
+            if (s->pas_courant < limite && !session_terminee(s)) {
+                jouer_image(&joueurs[i]);
+            } else {
+                synchroniser_session(s);
+                confirmes += session_confirmee(s);
+            }
+        }
+        avancer_boucle(boucle);
+        images++;
+        if (confirmes == nb_joueurs) break;
+    }
+    double secondes = horloge_secondes() - depart;
+
+    // tous les joueurs doivent voir exactement les mmes plateaux
+    int differences = 0;
+    for (int i = 0; i < nb_joueurs; i++) {
+        afficher_mesures(i, joueurs[i].session);
+        for (int k = 0; k < nb_joueurs; k++) {
+            differences += !jeux_identiques(joueurs[i].session->jeux[k], joueurs[0].session->jeux[k]);
+        }
+    }
+    printf("%lld images en %.2f s; plateaux identiques chez tous les joueurs: %s\n",
+           images, secondes, differences == 0 ? "oui" : "NON");
+
+    for (int i = 0; i < nb_joueurs; i++) {
+        detruire_session(joueurs[i].session);
+        detruire_pilote(joueurs[i].pilote);
+        detruire_jeu(joueurs[i].en_avance);
+    }
+    detruire_boucle_locale(boucle);
+    return differences != 0;
+}
+
+// fonction pour attendre la prochaine image
+void attendre(double secondes) {
+    if (secondes <= 0) return;
+#ifdef _WIN32
+    Sleep((DWORD)(secondes * 1000));
+#else
+    usleep((useconds_t)(secondes * 1e6));
+#endif
+}
+
+// fonction pour jouer un seul joueur en UDP
+int jouer_udp(int numero, int nb_joueurs, const char** adresses, int delai, int limite,
+              int largeur, int hauteur, uint64_t graine, int images_par_seconde) {
+    transport_reseau* transport = ouvrir_udp(numero, nb_joueurs, adresses);
+    if (transport == NULL) return 1;
+    session_reseau* s = creer_session(nb_joueurs, numero, delai, largeur, hauteur, graine, transport);
+    joueur_reseau joueur = { 0 };
+    if (s == NULL || preparer_joueur(&joueur, s) != 0) {
+        transport->fermer(transport);
+        return 1;
+    }
+
+    // les autres joueurs peuvent tre encore en retard  la fin: on continue
+    // d'changer les entres quelques secondes pour qu'ils puissent finir
+    double duree_image = 1.0 / images_par_seconde;
+    double prochaine = horloge_secondes();
+    double fin = 0;
+    while (fin == 0 || horloge_secondes() < fin) {
+        if (s->pas_courant < limite && !session_terminee(s)) {
+            jouer_image(&joueur);
+        } else {
+            synchroniser_session(s);
+            if (fin == 0 && session_confirmee(s)) fin = horloge_secondes() + 2.0;
+        }
+        prochaine += duree_image;
+        attendre(prochaine - horloge_secondes());
+    }
+
+    afficher_mesures(numero, s);
+    detruire_session(s);
+    detruire_pilote(joueur.pilote);
+    detruire_jeu(joueur.en_avance);
+    transport->fermer(transport);
+    return 0;
+}
+
+// fonction principale
+int main(int argc, char** argv) {
+    int nb_joueurs = 2;
+    int delai = 2;
+    int limite = 5000;
+    int largeur = largeur_jeu;
+    int hauteur = hauteur_jeu;
+    uint64_t graine = 1;
+    int latence = 4, gigue = 3, pertes = 50;
+    int numero = -1;
+    const char* adresses[nb_joueurs_max];
+    int nb_adresses = 0;
+    int images_par_seconde = 60;
+
+    // lire les options
+    for (int i = 1; i < argc; i++) {
+        const char* valeur = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "-n") == 0 && valeur) { nb_joueurs = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-d") == 0 && valeur) { delai = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-m") == 0 && valeur) { limite = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-p") == 0 && valeur && sscanf(valeur, "%dx%d", &largeur, &hauteur) == 2) { i++; }
+        else if (strcmp(argv[i], "-g") == 0 && valeur) { graine = strtoull(valeur, NULL, 10); i++; }
+        else if (strcmp(argv[i], "-l") == 0 && valeur) { latence = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-x") == 0 && valeur) { gigue = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-e") == 0 && valeur) { pertes = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-f") == 0 && valeur) { images_par_seconde = atoi(valeur); i++; }
+        else if (strcmp(argv[i], "-u") == 0 && valeur) {
+            numero = atoi(valeur);
+            for (i += 2; i < argc && argv[i][0] != '-' && nb_adresses < nb_joueurs_max; i++) {
+                adresses[nb_adresses++] = argv[i];
+            }
+            i--;
+        }
+        else {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+    }
+    if (images_par_seconde <= 0) images_par_seconde = 60;
+
+    if (numero >= 0) {
+        return jouer_udp(numero, nb_adresses, adresses, delai, limite, largeur, hauteur, graine, images_par_seconde);
+    }
+    return jouer_boucle_locale(nb_joueurs, delai, limite, largeur, hauteur, graine, latence, gigue, pertes);
+}
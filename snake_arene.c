@@ -0,0 +1,358 @@
+// arne de nombreux serpents (voir snake_arene.h)
+#include "snake_arene.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour retirer une case de la liste des cases vides (comme occuper_case_lot)
+static void occuper_case_arene(arene* a, int numero, int32_t occupant) {
+    int place = a->indice_libre[numero];
+    if (place >= 0) {
+        int derniere = a->cases_libres[--a->nb_libres];
+        a->cases_libres[place] = derniere;
+        a->indice_libre[derniere] = place;
+        a->indice_libre[numero] = -1;
+    }
+    a->occupant[numero] = occupant;
+}
+
+// fonction pour remettre une case dans la liste des cases vides
+static void liberer_case_arene(arene* a, int numero) {
+    if (a->indice_libre[numero] < 0) {
+        a->indice_libre[numero] = a->nb_libres;
+        a->cases_libres[a->nb_libres++] = numero;
+    }
+    a->occupant[numero] = case_vide_arene;
+}
+
+// fonction pour tirer une case vide (-1 si le plateau est plein)
+static int tirer_case_libre_arene(arene* a) {
+    if (a->nb_libres == 0) {
+        return -1;
+    }
+    return a->cases_libres[valeur_aleatoire(&a->hasard, 0, a->nb_libres - 1)];
+}
+
+// fonction pour faire apparatre un serpent d'une case sur une case vide
+// retourne 0 si le plateau est plein (le serpent reste mort)
+static int faire_apparaitre(arene* a, int s) {
+    int numero = tirer_case_libre_arene(a);
+    if (numero < 0) {
+        a->longueur[s] = 0;
+        return 0;
+    }
+    a->indice_tete[s] = 0;
+    a->indice_queue[s] = 0;
+    a->corps[s][0] = numero;
+    a->longueur[s] = 1;
+    a->croissance[s] = longueur_depart_arene - 1;
+    a->dir[s] = valeur_aleatoire(&a->hasard, dir_haut, dir_droite);
+    a->nb_pas[s] = 0;
+    occuper_case_arene(a, numero, s);
+    return 1;
+}
+
+// fonction pour reposer la nourriture mange
+static void poser_nourritures(arene* a) {
+    while (a->nourritures_posees < a->nb_nourritures) {
+        int numero = tirer_case_libre_arene(a);
+        if (numero < 0) return;
+        occuper_case_arene(a, numero, nourriture_arene);
+        a->nourritures_posees++;
+    }
+}
+
+// fonction pour doubler le tampon du corps d'un serpent
+// (les segments sont recopis depuis la queue au dbut du nouveau tampon)
+static int agrandir_corps(arene* a, int s) {
+    int capacite = a->capacite[s];
+    int32_t* corps = (int32_t*)malloc((size_t)capacite * 2 * sizeof(int32_t));
+    if (corps == NULL) {
+        printf("erreur: impossible d'agrandir le serpent %d\n", s);
+        return 1;
+    }
+    for (int i = 0; i < a->longueur[s]; i++) {
+        corps[i] = a->corps[s][(a->indice_queue[s] + i) & (capacite - 1)];
+    }
+    free(a->corps[s]);
+    a->corps[s] = corps;
+    a->capacite[s] = capacite * 2;
+    a->indice_queue[s] = 0;
+    a->indice_tete[s] = a->longueur[s] - 1;
+    return 0;
+}
+
+// fonction pour crer une arne et faire apparatre tous les serpents
+arene* creer_arene(int largeur, int hauteur, int nb_serpents, int nb_nourritures, uint64_t graine) {
+    arene* a = (arene*)calloc(1, sizeof(arene));
+    if (a == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour l'arne\n");
+        return NULL;
+    }
+
+    size_t n = (size_t)nb_serpents;
+    size_t cases = (size_t)largeur * hauteur;
+    a->largeur = largeur;
+    a->hauteur = hauteur;
+    a->nb_serpents = nb_serpents;
+    a->nb_nourritures = nb_nourritures;
+    initialiser_generateur(&a->hasard, graine);
+
+    int32_t** champs[] = {
+        &a->dir, &a->longueur, &a->croissance, &a->score, &a->nb_pas, &a->cible, &a->mort,
+        &a->evenements, &a->place_table, &a->capacite, &a->indice_tete, &a->indice_queue
+    };
+    int erreur = 0;
+    for (size_t k = 0; k < sizeof(champs) / sizeof(champs[0]); k++) {
+        *champs[k] = (int32_t*)calloc(n, sizeof(int32_t));
+        erreur |= *champs[k] == NULL;
+    }
+    a->corps = (int32_t**)calloc(n, sizeof(int32_t*));
+    a->occupant = (int32_t*)malloc(cases * sizeof(int32_t));
+    a->cases_libres = (int32_t*)malloc(cases * sizeof(int32_t));
+    a->indice_libre = (int32_t*)malloc(cases * sizeof(int32_t));
+    a->taille_table = 16;
+    while (a->taille_table < 2 * nb_serpents) a->taille_table *= 2;
+    a->table = (revendication*)calloc(a->taille_table, sizeof(revendication));
+    erreur |= a->corps == NULL || a->occupant == NULL || a->cases_libres == NULL ||
+              a->indice_libre == NULL || a->table == NULL;
+
+    for (size_t s = 0; !erreur && s < n; s++) {
+        a->capacite[s] = 4;
+        a->corps[s] = (int32_t*)malloc(4 * sizeof(int32_t));
+        erreur |= a->corps[s] == NULL;
+    }
+
+    if (erreur) {
+        printf("erreur: impossible d'allouer de la mmoire pour l'arne\n");
+        detruire_arene(a);
+        return NULL;
+    }
+
+    // toutes les cases sont vides, puis les serpents apparaissent dans l'ordre
+    for (size_t c = 0; c < cases; c++) {
+        a->occupant[c] = case_vide_arene;
+        a->cases_libres[c] = (int32_t)c;
+        a->indice_libre[c] = (int32_t)c;
+    }
+    a->nb_libres = (int)cases;
+    for (int s = 0; s < nb_serpents; s++) {
+        faire_apparaitre(a, s);
+    }
+    poser_nourritures(a);
+    return a;
+}
+
+// fonction pour librer une arne
+void detruire_arene(arene* a) {
+    if (a == NULL) return;
+
+    for (int s = 0; a->corps != NULL && s < a->nb_serpents; s++) {
+        free(a->corps[s]);
+    }
+    int32_t* champs[] = {
+        a->dir, a->longueur, a->croissance, a->score, a->nb_pas, a->cible, a->mort,
+        a->evenements, a->place_table, a->capacite, a->indice_tete, a->indice_queue,
+        a->occupant, a->cases_libres, a->indice_libre
+    };
+    for (size_t k = 0; k < sizeof(champs) / sizeof(champs[0]); k++) {
+        free(champs[k]);
+    }
+    free(a->corps);
+    free(a->table);
+    free(a);
+}
+
+// fonction pour noter qu'un serpent vise une case pendant ce tick
+// (adressage ouvert: les entres d'un autre tick sont libres, rien n'est effac entre deux ticks)
+static int revendiquer(arene* a, int s, int numero) {
+    uint32_t masque = (uint32_t)a->taille_table - 1;
+    uint32_t place = ((uint32_t)numero * 2654435761u) & masque;
+
+    for (;;) {
+        revendication* r = &a->table[place];
+        if (r->tour != a->tour) {
+            r->tour = a->tour;
+            r->numero = numero;
+            r->gagnant = s;
+            r->longueur = a->longueur[s];
+            r->egaux = 1;
+            return (int)place;
+        }
+        if (r->numero == numero) {
+            // une autre tte vise la mme case: le plus long serpent la garde
+            if (a->longueur[s] > r->longueur) {
+                r->gagnant = s;
+                r->longueur = a->longueur[s];
+                r->egaux = 1;
+            } else if (a->longueur[s] == r->longueur) {
+                r->egaux++;
+            }
+            return (int)place;
+        }
+        place = (place + 1) & masque;
+    }
+}
+
+// fonction pour faire avancer tous les serpents d'un pas
+int avancer_arene(arene* a, const int32_t* actions) {
+    double debut = horloge_secondes();
+    int n = a->nb_serpents;
+    int morts = 0;
+
+    if (++a->tour == 0) {
+        memset(a->table, 0, (size_t)a->taille_table * sizeof(revendication));
+        a->tour = 1;
+    }
+
+    // tape 1: directions, cases vises et murs
+    for (int s = 0; s < n; s++) {
+        a->evenements[s] = 0;
+        a->mort[s] = 0;
+        if (a->longueur[s] == 0) continue;  // pas de place pour rapparatre
+
+        int d = a->dir[s];
+        int action = actions != NULL ? actions[s] : -1;
+        // on ignore les actions ngatives et les demi-tours
+        d = (action < 0 || (action ^ d) == 1) ? d : action;
+        a->dir[s] = d;
+
+        int tete = a->corps[s][a->indice_tete[s]];
+        int x = tete % a->largeur + (d == dir_droite) - (d == dir_gauche);
+        int y = tete / a->largeur + (d == dir_bas) - (d == dir_haut);
+        if (x < 0 || x >= a->largeur || y < 0 || y >= a->hauteur) {
+            a->mort[s] = evenement_mort_mur;
+            continue;
+        }
+        a->cible[s] = y * a->largeur + x;
+        a->place_table[s] = revendiquer(a, s, a->cible[s]);
+    }
+
+    // tape 2: collisions, juges avant que les corps bougent
+    for (int s = 0; s < n; s++) {
+        if (a->longueur[s] == 0 || a->mort[s]) continue;
+
+        const revendication* r = &a->table[a->place_table[s]];
+        if (r->gagnant != s || r->egaux > 1) {
+            a->mort[s] = evenement_mort_tete;
+        } else if (a->occupant[a->cible[s]] >= 0) {
+            a->mort[s] = evenement_mort_serpent;  // un corps, ou une queue qui n'a pas encore boug
+        }
+    }
+
+    // tape 3: dplacement des survivants et repas
+    for (int s = 0; s < n; s++) {
+        if (a->longueur[s] == 0 || a->mort[s]) continue;
+
+        if (a->longueur[s] == a->capacite[s] && agrandir_corps(a, s) != 0) {
+            // plus de place pour la nouvelle tte: le serpent meurt et rapparat  l'tape 4
+            // (sa case vise reste libre: les autres ttes qui la visaient sont dj mortes)
+            a->mort[s] = evenement_erreur;
+            continue;
+        }
+        int masque = a->capacite[s] - 1;
+        int numero = a->cible[s];
+        int mange = a->occupant[numero] == nourriture_arene;
+
+        a->indice_tete[s] = (a->indice_tete[s] + 1) & masque;
+        a->corps[s][a->indice_tete[s]] = numero;
+        occuper_case_arene(a, numero, s);
+
+        if (a->croissance[s] > 0) {
+            a->croissance[s]--;
+            a->longueur[s]++;
+        } else {
+            liberer_case_arene(a, a->corps[s][a->indice_queue[s]]);
+            a->indice_queue[s] = (a->indice_queue[s] + 1) & masque;
+        }
+
+        if (mange) {
+            a->croissance[s]++;
+            a->score[s]++;
+            a->nourritures_posees--;
+            a->evenements[s] |= evenement_mange;
+            a->repas++;
+        }
+        a->nb_pas[s]++;
+        a->pas_serpents++;
+    }
+
+    // tape 4: les morts librent leurs cases et rapparaissent, puis la nourriture est repose
+    for (int s = 0; s < n; s++) {
+        if (!a->mort[s]) continue;
+
+        a->evenements[s] = a->mort[s];
+        a->morts_mur += a->mort[s] == evenement_mort_mur;
+        a->morts_serpent += a->mort[s] == evenement_mort_serpent;
+        a->morts_tete += a->mort[s] == evenement_mort_tete;
+        morts++;
+
+        int masque = a->capacite[s] - 1;
+        for (int i = 0; i < a->longueur[s]; i++) {
+            liberer_case_arene(a, a->corps[s][(a->indice_queue[s] + i) & masque]);
+        }
+        a->score[s] = 0;
+    }
+    for (int s = 0; s < n; s++) {
+        if (a->mort[s] || a->longueur[s] == 0) {
+            faire_apparaitre(a, s);
+        }
+    }
+    poser_nourritures(a);
+
+    a->ticks++;
+    a->secondes += horloge_secondes() - debut;
+    return morts;
+}
+
+// politique prudente: pour chaque serpent, la nourriture voisine d'abord, sinon tout droit
+// (ou une case au hasard une fois sur huit) parmi les cases qui ne tuent pas au prochain pas
+void actions_prudentes(const arene* a, int32_t* actions, generateur* hasard) {
+    static const int dx[4] = { 0, 0, -1, 1 };  // dir_haut, dir_bas, dir_gauche, dir_droite
+    static const int dy[4] = { -1, 1, 0, 0 };
+
+    for (int s = 0; s < a->nb_serpents; s++) {
+        actions[s] = -1;
+        if (a->longueur[s] == 0) continue;
+
+        int tete = a->corps[s][a->indice_tete[s]];
+        int x = tete % a->largeur;
+        int y = tete / a->largeur;
+        int tourner = valeur_aleatoire(hasard, 0, 7) == 0;
+        int depart = valeur_aleatoire(hasard, 0, 3);
+        int meilleure = -1;
+        int meilleure_valeur = -1;
+
+        for (int k = 0; k < 4; k++) {
+            int d = (depart + k) & 3;
+            if ((d ^ a->dir[s]) == 1) continue;  // pas de demi-tour
+            int nx = x + dx[d];
+            int ny = y + dy[d];
+            if (nx < 0 || nx >= a->largeur || ny < 0 || ny >= a->hauteur) continue;
+            int occupant = a->occupant[ny * a->largeur + nx];
+            if (occupant >= 0) continue;
+
+            int valeur = occupant == nourriture_arene ? 3 : (d == a->dir[s]) != tourner ? 2 : 1;
+            if (valeur > meilleure_valeur) {
+                meilleure_valeur = valeur;
+                meilleure = d;
+            }
+        }
+        actions[s] = meilleure;
+    }
+}
+
+// fonction pour calculer l'empreinte de l'arne (FNV-1a sur le plateau et les serpents)
+uint64_t empreinte_arene(const arene* a) {
+    uint64_t empreinte = 0xcbf29ce484222325ULL;
+    size_t cases = (size_t)a->largeur * a->hauteur;
+    for (size_t c = 0; c < cases; c++) {
+        empreinte = (empreinte ^ (uint32_t)a->occupant[c]) * 0x100000001b3ULL;
+    }
+    for (int s = 0; s < a->nb_serpents; s++) {
+        empreinte = (empreinte ^ (uint32_t)a->longueur[s]) * 0x100000001b3ULL;
+        empreinte = (empreinte ^ (uint32_t)a->score[s]) * 0x100000001b3ULL;
+        empreinte = (empreinte ^ (uint32_t)a->dir[s]) * 0x100000001b3ULL;
+    }
+    return empreinte;
+}
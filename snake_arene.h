@@ -0,0 +1,94 @@
+// arne: des centaines ou des milliers de serpents sur un mme grand plateau,
+// tous avancs  chaque tick
+// le plateau partag indique quel serpent occupe chaque case et garde la liste
+// des cases vides: une collision et une nourriture pose cotent O(1), quel que soit
+// le nombre de serpents. les cases vises pendant un tick sont ranges dans une table
+// de hachage pour reprer les ttes qui arrivent sur la mme case
+//
+// rgles d'un tick (le rsultat ne dpend pas de l'ordre des serpents):
+// - toutes les collisions sont juges avant qu'un serpent bouge: les queues comptent
+//   comme des obstacles, comme dans deplacer_serpent
+// - si plusieurs ttes visent la mme case, le plus long serpent la prend et les autres
+//   meurent;  longueur gale, ils meurent tous
+// - un serpent mort libre ses cases et rapparat ailleurs  la fin du tick
+// - l'arne n'a que de la nourriture normale (pas de fruit bonus)
+#ifndef SNAKE_ARENE_H
+#define SNAKE_ARENE_H
+
+#include "snake_moteur.h"
+
+#define case_vide_arene (-1)       // occupant d'une case vide
+#define nourriture_arene (-2)      // occupant d'une case de nourriture
+#define evenement_mort_tete (evenement_erreur << 1)   // collision tte contre tte (en plus de evenement)
+#define longueur_depart_arene 3    // un serpent apparat sur une case et grandit jusqu' cette longueur
+
+// case vise pendant un tick (entre de la table de hachage)
+typedef struct {
+    uint32_t tour;                 // tick de l'entre (les autres entres sont libres)
+    int32_t numero;                // case vise
+    int32_t gagnant;               // plus long serpent qui la vise
+    int32_t longueur;              // longueur du gagnant
+    int32_t egaux;                 // serpents qui la visent avec cette longueur
+} revendication;
+
+typedef struct {
+    int largeur;
+    int hauteur;
+    int nb_serpents;
+    int nb_nourritures;            // nourritures prsentes en mme temps sur le plateau
+    generateur hasard;             // tirages de l'arne (apparitions et nourriture)
+
+    // plateau partag
+    int32_t* occupant;             // serpent de chaque case, case_vide_arene ou nourriture_arene
+    int32_t* cases_libres;         // liste compacte des cases vides
+    int32_t* indice_libre;         // place de chaque case dans cases_libres (-1 si occupe)
+    int nb_libres;
+    int nourritures_posees;
+
+    // serpents: un tableau de nb_serpents entiers par champ
+    int32_t* dir;
+    int32_t* longueur;
+    int32_t* croissance;
+    int32_t* score;
+    int32_t* nb_pas;               // pas depuis la dernire apparition
+    int32_t* cible;                // case vise pendant ce tick
+    int32_t* mort;                 // cause de la mort pendant ce tick (0 si vivant)
+    int32_t* evenements;           // vnements du dernier tick
+    int32_t* place_table;          // entre de la table pour la case vise
+    int32_t** corps;               // numros des cases du corps (tampon circulaire par serpent)
+    int32_t* capacite;             // taille de chaque tampon (puissance de 2)
+    int32_t* indice_tete;
+    int32_t* indice_queue;
+
+    // table des cases vises (puissance de 2, au moins deux fois le nombre de serpents)
+    revendication* table;
+    int taille_table;
+    uint32_t tour;
+
+    // compteurs
+    long long ticks;
+    long long pas_serpents;        // dplacements russis
+    long long morts_mur;
+    long long morts_serpent;
+    long long morts_tete;
+    long long repas;
+    double secondes;               // temps pass dans avancer_arene
+} arene;
+
+arene* creer_arene(int largeur, int hauteur, int nb_serpents, int nb_nourritures, uint64_t graine);
+void detruire_arene(arene* a);
+
+// un tick pour tous les serpents; actions peut tre NULL (garder les directions)
+// une action est une direction, ou -1 pour garder la direction actuelle
+// un serpent qui ne peut pas grandir faute de mmoire meurt (evenement_erreur) au lieu d'arrter le programme
+// retourne le nombre de serpents morts pendant ce tick
+int avancer_arene(arene* a, const int32_t* actions);
+
+// politique fournie: vite les cases mortelles au prochain pas, mange la nourriture voisine
+// et tourne de temps en temps au hasard
+void actions_prudentes(const arene* a, int32_t* actions, generateur* hasard);
+
+// empreinte de l'tat de l'arne (pour vrifier que deux simulations sont identiques)
+uint64_t empreinte_arene(const arene* a);
+
+#endif
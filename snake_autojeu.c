@@ -0,0 +1,336 @@
+// parties joues automatiquement sur tous les coeurs (voir snake_autojeu.h)
+#include "snake_autojeu.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// une tche: un paquet de parties conscutives (leurs graines se suivent)
+typedef struct {
+    long long premiere;            // numro de la premire partie
+    int nombre;                    // nombre de parties
+} tache;
+
+// file de tches d'un fil d'excution (file de Chase-Lev sans agrandissement):
+// le propritaire prend par le bas, les autres fils volent par le haut.
+// toutes les tches sont dposes avant le dpart des fils
+typedef struct {
+    _Atomic long haut;             // prochaine tche  voler
+    char separation[64];           // haut et bas sur des lignes de cache diffrentes
+    _Atomic long bas;              // aprs la dernire tche
+    tache* taches;
+} file_taches;
+
+// tat d'un fil d'excution; chaque fil n'crit que dans le sien
+typedef struct {
+    pthread_t fil;
+    int numero;
+    int nb_fils;
+    const config_autojeu* config;
+    file_taches* files;            // les files de tous les fils
+    resultats_autojeu resultats;   // rsultats de ce fil, cumuls  la fin sans verrou
+    int erreur;
+} travailleur;
+
+// fonction pour que le propritaire prenne la dernire tche de sa file
+static int prendre_tache(file_taches* file, tache* t) {
+    long b = atomic_load_explicit(&file->bas, memory_order_relaxed) - 1;
+    atomic_store_explicit(&file->bas, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long h = atomic_load_explicit(&file->haut, memory_order_relaxed);
+
+    if (h > b) {
+        // file vide
+        atomic_store_explicit(&file->bas, b + 1, memory_order_relaxed);
+        return 0;
+    }
+
+    *t = file->taches[b];
+    if (h < b) {
+        return 1;
+    }
+
+    // dernire tche: un voleur peut la prendre en mme temps
+    int gagne = atomic_compare_exchange_strong_explicit(&file->haut, &h, h + 1,
+                                                        memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&file->bas, b + 1, memory_order_relaxed);
+    return gagne;
+}
+
+// fonction pour voler la premire tche de la file d'un autre fil
+// retourne 1 si vole, 0 si la file est vide, -1 si un autre fil a t plus rapide
+static int voler_tache(file_taches* file, tache* t) {
+    long h = atomic_load_explicit(&file->haut, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&file->bas, memory_order_acquire);
+
+    if (h >= b) {
+        return 0;
+    }
+
+    *t = file->taches[h];
+    if (!atomic_compare_exchange_strong_explicit(&file->haut, &h, h + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return -1;
+    }
+    return 1;
+}
+
+// fonction pour trouver la prochaine tche: la sienne d'abord, sinon celle d'un autre
+static int tache_suivante(travailleur* t, tache* suivante) {
+    if (prendre_tache(&t->files[t->numero], suivante)) {
+        return 1;
+    }
+
+    // aucune tche n'est ajoute pendant le jeu: si toutes les files
+    // sont vides pendant un tour complet, tout est fini
+    int concurrence;
+    do {
+        concurrence = 0;
+        for (int k = 1; k < t->nb_fils; k++) {
+            int victime = (t->numero + k) % t->nb_fils;
+            int vol = voler_tache(&t->files[victime], suivante);
+            if (vol > 0) {
+                return 1;
+            }
+            concurrence |= vol < 0;
+        }
+    } while (concurrence);
+
+    return 0;
+}
+
+// fonction pour noter le rsultat d'une partie termine
+static void noter_partie(resultats_autojeu* r, int score, int longueur, int cause) {
+    r->parties++;
+    r->somme_scores += score;
+    r->somme_longueurs += longueur;
+    r->scores[score < nb_scores_max ? score : nb_scores_max - 1]++;
+    if (score > r->score_max) {
+        r->score_max = score;
+    }
+
+    if (cause & evenement_mort_mur) {
+        r->morts_mur++;
+    } else if (cause & evenement_mort_serpent) {
+        r->morts_serpent++;
+    } else {
+        r->limites++;
+    }
+}
+
+// fonction pour jouer toutes les parties d'une tche avec le lot du fil
+static void jouer_tache(travailleur* t, lot_snake* lot, int32_t* actions, tache* paquet) {
+    const config_autojeu* config = t->config;
+    resultats_autojeu* r = &t->resultats;
+    long long suivante = paquet->premiere;
+    long long fin = paquet->premiere + paquet->nombre;
+    int en_cours = 0;
+    generateur hasard;
+
+    // le hasard de la politique ne dpend que de la tche:
+    // les rsultats ne dpendent pas du fil qui la joue
+    initialiser_generateur(&hasard, config->graine ^ ((uint64_t)paquet->premiere * 0x9e3779b97f4a7c15ULL));
+
+    for (int i = 0; i < lot->nb_parties; i++) {
+        if (suivante < fin) {
+            reinitialiser_partie_lot(lot, i, config->graine + suivante++);
+            en_cours++;
+        } else {
+            lot->game_over[i] = 1;  // emplacement inutilis
+        }
+    }
+
+    while (en_cours > 0) {
+        config->politique(lot, actions, &hasard, config->contexte);
+        avancer_lot(lot, actions);
+
+        for (int i = 0; i < lot->nb_parties; i++) {
+            int cause = lot->evenements[i] & (evenement_mort_mur | evenement_mort_serpent);
+            int limite = !lot->game_over[i] && config->limite_pas > 0 && lot->nb_pas[i] >= config->limite_pas;
+            if (!cause && !limite) continue;
+
+            if (cause) {
+                noter_partie(r, lot->fin_score[i], lot->fin_longueur[i], cause);
+            } else {
+                noter_partie(r, lot->score[i], lot->longueur[i] + lot->croissance[i], 0);
+                lot->game_over[i] = 1;
+            }
+
+            // relancer l'emplacement avec la partie suivante de la tche
+            if (suivante < fin) {
+                reinitialiser_partie_lot(lot, i, config->graine + suivante++);
+            } else {
+                en_cours--;
+            }
+        }
+    }
+}
+
+// fonction excute par chaque fil
+static void* boucle_travailleur(void* argument) {
+    travailleur* t = (travailleur*)argument;
+    lot_snake* lot = creer_lot(t->config->largeur_lot, t->config->graine);
+    int32_t* actions = (int32_t*)malloc(t->config->largeur_lot * sizeof(int32_t));
+    tache paquet;
+
+    if (lot == NULL || actions == NULL) {
+        t->erreur = 1;
+    } else {
+        lot->reinitialisation_auto = 0;  // les relances sont faites par jouer_tache
+        while (tache_suivante(t, &paquet)) {
+            jouer_tache(t, lot, actions, &paquet);
+        }
+        t->resultats.pas = lot->pas_total;
+    }
+
+    free(actions);
+    detruire_lot(lot);
+    return NULL;
+}
+
+// fonction pour jouer toutes les parties demandes
+int lancer_autojeu(const config_autojeu* demande, resultats_autojeu* resultats) {
+    config_autojeu config = *demande;
+    memset(resultats, 0, sizeof(resultats_autojeu));
+
+    if (config.nb_fils <= 0) {
+        config.nb_fils = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (config.nb_fils <= 0) config.nb_fils = 1;
+    }
+    if (config.largeur_lot <= 0) config.largeur_lot = 256;
+    if (config.parties_par_tache <= 0) config.parties_par_tache = config.largeur_lot;
+    if (config.largeur_lot > config.parties_par_tache) config.largeur_lot = config.parties_par_tache;
+    if (config.politique == NULL) config.politique = politique_hasard;
+
+    long long nb_taches = (config.nb_parties + config.parties_par_tache - 1) / config.parties_par_tache;
+    file_taches* files = (file_taches*)calloc(config.nb_fils, sizeof(file_taches));
+    travailleur* travailleurs = (travailleur*)calloc(config.nb_fils, sizeof(travailleur));
+    tache* taches = (tache*)malloc((nb_taches > 0 ? nb_taches : 1) * sizeof(tache));
+
+    if (files == NULL || travailleurs == NULL || taches == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour l'autojeu\n");
+        free(files);
+        free(travailleurs);
+        free(taches);
+        return 1;
+    }
+
+    // dcouper les parties en tches; chaque fil reoit un bloc de tches conscutives
+    long long debut = 0;
+    for (int f = 0; f < config.nb_fils; f++) {
+        long long fin = nb_taches * (f + 1) / config.nb_fils;
+        files[f].taches = taches + debut;
+        atomic_init(&files[f].haut, 0);
+        atomic_init(&files[f].bas, (long)(fin - debut));
+        for (long long k = debut; k < fin; k++) {
+            long long premiere = k * config.parties_par_tache;
+            long long reste = config.nb_parties - premiere;
+            taches[k].premiere = premiere;
+            taches[k].nombre = (int)(reste < config.parties_par_tache ? reste : config.parties_par_tache);
+        }
+        debut = fin;
+    }
+
+    double depart = horloge_secondes();
+    int erreur = 0;
+
+    for (int f = 0; f < config.nb_fils; f++) {
+        travailleurs[f].numero = f;
+        travailleurs[f].nb_fils = config.nb_fils;
+        travailleurs[f].config = &config;
+        travailleurs[f].files = files;
+        if (pthread_create(&travailleurs[f].fil, NULL, boucle_travailleur, &travailleurs[f]) != 0) {
+            // les tches de ce fil seront voles par les autres
+            travailleurs[f].erreur = -1;
+        }
+    }
+
+    // cumuler les rsultats de chaque fil une fois qu'il a fini
+    for (int f = 0; f < config.nb_fils; f++) {
+        if (travailleurs[f].erreur < 0) continue;
+        pthread_join(travailleurs[f].fil, NULL);
+        erreur |= travailleurs[f].erreur;
+
+        resultats_autojeu* r = &travailleurs[f].resultats;
+        resultats->parties += r->parties;
+        resultats->pas += r->pas;
+        resultats->morts_mur += r->morts_mur;
+        resultats->morts_serpent += r->morts_serpent;
+        resultats->limites += r->limites;
+        resultats->somme_scores += r->somme_scores;
+        resultats->somme_longueurs += r->somme_longueurs;
+        for (int s = 0; s < nb_scores_max; s++) {
+            resultats->scores[s] += r->scores[s];
+        }
+        if (r->score_max > resultats->score_max) {
+            resultats->score_max = r->score_max;
+        }
+    }
+    resultats->secondes = horloge_secondes() - depart;
+
+    free(files);
+    free(travailleurs);
+    free(taches);
+    return erreur || resultats->parties != config.nb_parties;
+}
+
+// fonction pour trouver le score sous lequel se trouve une fraction des parties
+int quantile_scores(const resultats_autojeu* resultats, double fraction) {
+    long long cible = (long long)(fraction * resultats->parties);
+    long long cumul = 0;
+    for (int s = 0; s < nb_scores_max; s++) {
+        cumul += resultats->scores[s];
+        if (cumul > cible) {
+            return s;
+        }
+    }
+    return resultats->score_max;
+}
+
+// politique qui tourne au hasard de temps en temps
+void politique_hasard(const lot_snake* lot, int32_t* actions, generateur* hasard, void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < lot->nb_parties; i++) {
+        int tirage = valeur_aleatoire(hasard, 0, 7);
+        actions[i] = tirage < 4 ? tirage : -1;
+    }
+}
+
+// politique qui va vers la nourriture en vitant les cases mortelles au prochain pas
+void politique_gourmande(const lot_snake* lot, int32_t* actions, generateur* hasard, void* contexte) {
+    (void)contexte;
+    static const int dx[4] = { 0, 0, -1, 1 };  // dir_haut, dir_bas, dir_gauche, dir_droite
+    static const int dy[4] = { -1, 1, 0, 0 };
+
+    for (int i = 0; i < lot->nb_parties; i++) {
+        const unsigned char* grille = lot->grille + (size_t)i * nb_cases;
+        int x = lot->tete_x[i];
+        int y = lot->tete_y[i];
+        int cible = lot->nourriture[i];
+        int meilleure = -1;
+        int meilleure_distance = 1 << 30;
+        int depart = valeur_aleatoire(hasard, 0, 3);  // dpartage les galits
+
+        for (int k = 0; k < 4; k++) {
+            int d = (depart + k) & 3;
+            int nx = x + dx[d];
+            int ny = y + dy[d];
+            if ((d ^ lot->dir[i]) == 1) continue;  // pas de demi-tour
+            if (nx < 0 || nx >= largeur_jeu || ny < 0 || ny >= hauteur_jeu) continue;
+            if (grille[ny * largeur_jeu + nx] == case_serpent) continue;
+
+            int distance = 0;
+            if (cible >= 0) {
+                distance = abs(cible % largeur_jeu - nx) + abs(cible / largeur_jeu - ny);
+            }
+            if (distance < meilleure_distance) {
+                meilleure_distance = distance;
+                meilleure = d;
+            }
+        }
+        actions[i] = meilleure;  // -1 si aucune case n'est sre
+    }
+}
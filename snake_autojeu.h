@@ -0,0 +1,53 @@
+// parties joues automatiquement sur tous les coeurs de la machine
+// les parties sont dcoupes en tches (paquets de parties conscutives);
+// chaque fil d'excution joue ses tches avec son propre lot_snake et vole
+// celles des autres quand il n'en a plus
+#ifndef SNAKE_AUTOJEU_H
+#define SNAKE_AUTOJEU_H
+
+#include "snake_lot.h"
+
+#define nb_scores_max 1024         // taille de l'histogramme des scores (le dernier compte tout ce qui dpasse)
+
+// politique de jeu: choisit une action pour chaque partie du lot
+// (une direction, ou -1 pour garder la direction actuelle)
+// hasard est propre au fil d'excution et rinitialis  chaque tche
+typedef void (*politique_lot)(const lot_snake* lot, int32_t* actions, generateur* hasard, void* contexte);
+
+// paramtres d'une srie de parties
+typedef struct {
+    long long nb_parties;          // nombre total de parties  jouer
+    int nb_fils;                   // fils d'excution (0 = un par coeur)
+    int largeur_lot;               // parties joues en mme temps par chaque fil
+    int parties_par_tache;         // parties dans une tche
+    int limite_pas;                // pas maximum par partie (0 = sans limite)
+    uint64_t graine;               // graine de la premire partie
+    politique_lot politique;       // qui joue
+    void* contexte;                // donnes de la politique (partages, en lecture seule)
+} config_autojeu;
+
+// rsultats cumuls d'une srie de parties
+typedef struct {
+    long long parties;             // parties termines
+    long long pas;                 // pas de partie jous
+    long long morts_mur;           // parties perdues contre un mur
+    long long morts_serpent;       // parties perdues contre le serpent
+    long long limites;             // parties arrtes par limite_pas
+    long long somme_scores;
+    long long somme_longueurs;
+    long long scores[nb_scores_max];  // nombre de parties par score final
+    int score_max;
+    double secondes;               // dure totale
+} resultats_autojeu;
+
+// politiques fournies
+void politique_hasard(const lot_snake* lot, int32_t* actions, generateur* hasard, void* contexte);
+void politique_gourmande(const lot_snake* lot, int32_t* actions, generateur* hasard, void* contexte);
+
+// joue toutes les parties et remplit les rsultats; retourne 0 si tout s'est bien pass
+int lancer_autojeu(const config_autojeu* config, resultats_autojeu* resultats);
+
+// score sous lequel se trouve une fraction des parties (0.5 = mdiane)
+int quantile_scores(const resultats_autojeu* resultats, double fraction);
+
+#endif
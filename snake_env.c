@@ -0,0 +1,235 @@
+// environnement d'apprentissage par renforcement (voir snake_env.h)
+#include "snake_env.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour trouver le plan d'une partie dans un tableau d'observations
+static uint8_t* plan_partie(uint8_t* observations, int i, int plan) {
+    return observations + ((size_t)i * nb_plans_env + plan) * nb_cases;
+}
+
+// fonction pour coder un fruit de la rserve comme il est crit (-1 si inactif)
+static int32_t fruit_ecrit(const fruit* f) {
+    return f->actif ? (int32_t)f->type * nb_cases + f->pos.y * largeur_jeu + f->pos.x : -1;
+}
+
+// fonction pour crire l'observation complte de la partie i dans observation (ses nb_plans_env plans)
+// sans toucher  ce que l'environnement a not comme crit
+static void ecrire_observation(const lot_snake* lot, int i, uint8_t* observation) {
+    memset(observation, 0, taille_observation_env);
+
+    const int32_t* corps = lot->corps + (size_t)i * nb_cases;
+    uint8_t* plan = observation + plan_corps * nb_cases;
+    int indice = lot->indice_queue[i];
+    for (int k = 0; k < lot->longueur[i]; k++) {
+        plan[corps[indice]] = 1;
+        indice = (indice + 1) % nb_cases;
+    }
+    observation[plan_tete * nb_cases + corps[lot->indice_tete[i]]] = 1;
+    observation[plan_queue * nb_cases + corps[lot->indice_queue[i]]] = 1;
+
+    if (lot->nourriture[i] >= 0) {
+        observation[plan_nourriture * nb_cases + lot->nourriture[i]] = 1;
+    }
+    const fruit* fruits = lot->fruits + (size_t)i * nb_fruits_max;
+    for (int k = 0; k < nb_fruits_max; k++) {
+        int32_t code = fruit_ecrit(&fruits[k]);
+        if (code >= 0) {
+            observation[plan_fruits * nb_cases + code] = 1;
+        }
+    }
+}
+
+// fonction pour rcrire toute l'observation de la partie i et noter ce qui est crit
+static void reecrire_partie(env_snake* env, int i) {
+    const lot_snake* lot = env->lot;
+    ecrire_observation(lot, i, plan_partie(env->observations, i, 0));
+
+    env->tetes_ecrites[i] = lot->corps[(size_t)i * nb_cases + lot->indice_tete[i]];
+    env->queues_ecrites[i] = lot->corps[(size_t)i * nb_cases + lot->indice_queue[i]];
+    env->nourritures_ecrites[i] = lot->nourriture[i];
+    for (int k = 0; k < nb_fruits_max; k++) {
+        env->fruits_ecrits[(size_t)i * nb_fruits_max + k] = fruit_ecrit(&lot->fruits[(size_t)i * nb_fruits_max + k]);
+    }
+}
+
+// fonction pour rcrire seulement les cases de la partie i qui ont chang pendant le pas
+// (le serpent avance d'une case par pas: une tte en plus, au plus une queue en moins)
+static void mettre_a_jour_partie(env_snake* env, int i) {
+    const lot_snake* lot = env->lot;
+    uint8_t* observations = env->observations;
+
+    int tete = lot->corps[(size_t)i * nb_cases + lot->indice_tete[i]];
+    if (tete != env->tetes_ecrites[i]) {
+        plan_partie(observations, i, plan_tete)[env->tetes_ecrites[i]] = 0;
+        plan_partie(observations, i, plan_tete)[tete] = 1;
+        plan_partie(observations, i, plan_corps)[tete] = 1;
+        env->tetes_ecrites[i] = tete;
+    }
+
+    int queue = lot->corps[(size_t)i * nb_cases + lot->indice_queue[i]];
+    if (queue != env->queues_ecrites[i]) {
+        plan_partie(observations, i, plan_corps)[env->queues_ecrites[i]] = 0;
+        plan_partie(observations, i, plan_queue)[env->queues_ecrites[i]] = 0;
+        plan_partie(observations, i, plan_queue)[queue] = 1;
+        env->queues_ecrites[i] = queue;
+    }
+
+    int nourriture = lot->nourriture[i];
+    if (nourriture != env->nourritures_ecrites[i]) {
+        if (env->nourritures_ecrites[i] >= 0) {
+            plan_partie(observations, i, plan_nourriture)[env->nourritures_ecrites[i]] = 0;
+        }
+        if (nourriture >= 0) {
+            plan_partie(observations, i, plan_nourriture)[nourriture] = 1;
+        }
+        env->nourritures_ecrites[i] = nourriture;
+    }
+
+    // les fruits: le code contient le type, donc le plan (les plans des fruits se suivent)
+    uint8_t* plans_fruits = plan_partie(observations, i, plan_fruits);
+    const fruit* fruits = lot->fruits + (size_t)i * nb_fruits_max;
+    int32_t* ecrits = env->fruits_ecrits + (size_t)i * nb_fruits_max;
+    for (int k = 0; k < nb_fruits_max; k++) {
+        int32_t code = fruit_ecrit(&fruits[k]);
+        if (code != ecrits[k]) {
+            if (ecrits[k] >= 0) plans_fruits[ecrits[k]] = 0;
+            if (code >= 0) plans_fruits[code] = 1;
+            ecrits[k] = code;
+        }
+    }
+}
+
+// fonction pour crer un environnement de nb_parties parties
+env_snake* creer_env(int nb_parties, int limite_pas) {
+    env_snake* env = (env_snake*)calloc(1, sizeof(env_snake));
+    if (env == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour l'environnement\n");
+        return NULL;
+    }
+
+    size_t n = (size_t)nb_parties;
+    env->limite_pas = limite_pas;
+    env->lot = creer_lot(nb_parties, 0);
+
+    int32_t** champs[] = {
+        &env->tetes_ecrites, &env->queues_ecrites, &env->nourritures_ecrites, &env->scores_precedents
+    };
+    int erreur = env->lot == NULL;
+    for (size_t k = 0; k < sizeof(champs) / sizeof(champs[0]); k++) {
+        *champs[k] = (int32_t*)calloc(n, sizeof(int32_t));
+        erreur |= *champs[k] == NULL;
+    }
+    env->fruits_ecrits = (int32_t*)calloc(n * nb_fruits_max, sizeof(int32_t));
+    erreur |= env->fruits_ecrits == NULL;
+
+    if (erreur) {
+        printf("erreur: impossible d'allouer de la mmoire pour l'environnement\n");
+        detruire_env(env);
+        return NULL;
+    }
+
+    env->lot->reinitialisation_auto = 1;
+    return env;
+}
+
+// fonction pour librer un environnement (les tableaux de l'appelant ne sont pas librs)
+void detruire_env(env_snake* env) {
+    if (env == NULL) return;
+
+    detruire_lot(env->lot);
+    free(env->tetes_ecrites);
+    free(env->queues_ecrites);
+    free(env->nourritures_ecrites);
+    free(env->scores_precedents);
+    free(env->fruits_ecrits);
+    free(env);
+}
+
+// fonction pour donner  l'environnement les tableaux de l'appelant
+void attacher_env(env_snake* env, uint8_t* observations, float* recompenses, uint8_t* terminees) {
+    env->observations = observations;
+    env->recompenses = recompenses;
+    env->terminees = terminees;
+}
+
+// fonction pour relancer toutes les parties
+void reinitialiser_env(env_snake* env, uint64_t graine) {
+    lot_snake* lot = env->lot;
+    for (int i = 0; i < lot->nb_parties; i++) {
+        reinitialiser_partie_lot(lot, i, graine + i);
+        if (env->observations) reecrire_partie(env, i);
+        env->scores_precedents[i] = lot->score[i];
+        if (env->recompenses) env->recompenses[i] = 0.0f;
+        if (env->terminees) env->terminees[i] = fin_aucune;
+    }
+    lot->graine_suivante = graine + lot->nb_parties;
+}
+
+// fonction pour faire un pas dans toutes les parties
+int avancer_env(env_snake* env, const int32_t* actions) {
+    double debut = horloge_secondes();
+    lot_snake* lot = env->lot;
+    int n = lot->nb_parties;
+
+    int terminees = avancer_lot(lot, actions);
+
+    for (int i = 0; i < n; i++) {
+        int fin = fin_aucune;
+        float recompense;
+
+        if (lot->mort[i]) {
+            // la partie a dj t relance par le lot: ses points viennent de fin_score
+            fin = fin_perdue;
+            recompense = (float)(lot->fin_score[i] - env->scores_precedents[i]) + recompense_mort;
+        } else {
+            recompense = (float)(lot->score[i] - env->scores_precedents[i]);
+            if (env->limite_pas > 0 && lot->nb_pas[i] >= env->limite_pas) {
+                fin = fin_limite;
+                reinitialiser_partie_lot(lot, i, lot->graine_suivante++);
+                terminees++;
+            }
+        }
+
+        if (env->observations) {
+            if (fin != fin_aucune) {
+                reecrire_partie(env, i);
+            } else {
+                mettre_a_jour_partie(env, i);
+            }
+        }
+        env->scores_precedents[i] = lot->score[i];
+        if (env->recompenses) env->recompenses[i] = recompense;
+        if (env->terminees) env->terminees[i] = (uint8_t)fin;
+    }
+
+    env->pas_total += n;
+    env->secondes += horloge_secondes() - debut;
+    return terminees;
+}
+
+// fonction pour vrifier les observations de toutes les parties
+int verifier_observations_env(const env_snake* env) {
+    if (env->observations == NULL) return 0;
+
+    uint8_t* attendue = (uint8_t*)malloc(taille_observation_env);
+    if (attendue == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour la vrification\n");
+        return -1;
+    }
+
+    int differences = 0;
+    for (int i = 0; i < env->lot->nb_parties; i++) {
+        ecrire_observation(env->lot, i, attendue);
+        differences += memcmp(attendue, plan_partie(env->observations, i, 0), taille_observation_env) != 0;
+    }
+
+    free(attendue);
+    return differences;
+}
+
+// fonction pour calculer le dbit de l'environnement
+double debit_env(const env_snake* env) {
+    return env->secondes > 0 ? env->pas_total / env->secondes : 0.0;
+}
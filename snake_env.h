@@ -0,0 +1,81 @@
+// environnement d'apprentissage par renforcement au-dessus du simulateur par lots
+// interface C simple (pointeurs et entiers seulement) pour tre appele depuis un autre langage:
+// reinitialiser_env(graine) puis avancer_env(actions) sur toutes les parties  la fois
+// les observations sont crites directement dans les tableaux de l'appelant, sans copie:
+//  chaque pas seules les cases qui ont chang sont rcrites, et aucune allocation n'est faite
+#ifndef SNAKE_ENV_H
+#define SNAKE_ENV_H
+
+#include "snake_lot.h"
+
+// plans d'une observation: hauteur_jeu x largeur_jeu octets (0 ou 1) par plan
+typedef enum {
+    plan_tete = 0,          // tte du serpent
+    plan_corps,             // toutes les cases du serpent (tte et queue comprises)
+    plan_queue,             // queue du serpent
+    plan_nourriture,        // nourriture
+    plan_fruits,            // fruits de la rserve: un plan par type_fruit  partir d'ici
+    nb_plans_env = plan_fruits + fruit_bonus_taille + 1
+} plan_env;
+
+// octets d'une observation (une partie)
+#define taille_observation_env (nb_plans_env * nb_cases)
+
+// rcompenses
+#ifndef recompense_mort
+#define recompense_mort -1.0f      // ajoute quand la partie est perdue
+#endif
+
+// fins de partie (tableau terminees)
+typedef enum {
+    fin_aucune = 0,         // la partie continue
+    fin_perdue,             // mur ou serpent: la partie a t relance
+    fin_limite              // limite_pas atteinte: la partie a t relance
+} fin_env;
+
+// structure de l'environnement
+typedef struct {
+    lot_snake* lot;
+    int limite_pas;                 // pas maximum par partie (0 = sans limite)
+
+    // tableaux de l'appelant (attacher_env)
+    uint8_t* observations;          // [nb_parties][nb_plans_env][hauteur_jeu][largeur_jeu]
+    float* recompenses;             // [nb_parties]
+    uint8_t* terminees;             // [nb_parties] (fin_env)
+
+    // ce qui est crit dans les observations, pour ne rcrire que les diffrences
+    int32_t* tetes_ecrites;         // numro de case de la tte
+    int32_t* queues_ecrites;        // numro de case de la queue
+    int32_t* nourritures_ecrites;   // numro de case de la nourriture (-1 si aucune)
+    int32_t* fruits_ecrits;         // nb_fruits_max par partie: type * nb_cases + case (-1 si aucun)
+    int32_t* scores_precedents;     // score avant le pas
+
+    long long pas_total;            // pas d'environnement (parties x pas)
+    double secondes;                // temps pass dans avancer_env
+} env_snake;
+
+// cration et destruction
+env_snake* creer_env(int nb_parties, int limite_pas);
+void detruire_env(env_snake* env);
+
+// donne les tableaux de l'appelant: observations de nb_parties * taille_observation_env octets,
+// recompenses et terminees de nb_parties valeurs (recompenses et terminees peuvent tre NULL)
+// les observations sont rcrites en entier au prochain reinitialiser_env
+void attacher_env(env_snake* env, uint8_t* observations, float* recompenses, uint8_t* terminees);
+
+// relance toutes les parties (la partie i avec graine + i) et crit les observations compltes
+void reinitialiser_env(env_snake* env, uint64_t graine);
+
+// un pas pour toutes les parties: actions contient une direction par partie (-1 = garder la direction)
+// les parties termines sont relances aussitt et leur observation est celle de la nouvelle partie
+// retourne le nombre de parties termines pendant ce pas
+int avancer_env(env_snake* env, const int32_t* actions);
+
+// compare les observations  une rcriture complte (pour vrifier les mises  jour partielles)
+// retourne le nombre de parties dont l'observation diffre
+int verifier_observations_env(const env_snake* env);
+
+// mesures
+double debit_env(const env_snake* env);   // pas d'environnement par seconde
+
+#endif
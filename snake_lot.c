@@ -0,0 +1,543 @@
+// simulateur par lots de parties (voir snake_lot.h)
+#include "snake_lot.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fonction pour retirer une case de la liste des cases vides d'une partie
+// (mme algorithme que occuper_case pour tirer les mmes cases)
+static void occuper_case_lot(lot_snake* lot, int i, int numero, contenu_case contenu) {
+    int32_t* libres = lot->cases_libres + (size_t)i * nb_cases;
+    int32_t* indices = lot->indice_libre + (size_t)i * nb_cases;
+    int place = indices[numero];
+
+    if (place >= 0) {
+        int derniere = libres[--lot->nb_libres[i]];
+        libres[place] = derniere;
+        indices[derniere] = place;
+        indices[numero] = -1;
+    }
+
+    lot->grille[(size_t)i * nb_cases + numero] = contenu;
+}
+
+// fonction pour remettre une case dans la liste des cases vides d'une partie
+static void liberer_case_lot(lot_snake* lot, int i, int numero) {
+    int32_t* libres = lot->cases_libres + (size_t)i * nb_cases;
+    int32_t* indices = lot->indice_libre + (size_t)i * nb_cases;
+
+    if (indices[numero] < 0) {
+        indices[numero] = lot->nb_libres[i];
+        libres[lot->nb_libres[i]++] = numero;
+    }
+
+    lot->grille[(size_t)i * nb_cases + numero] = case_vide;
+}
+
+// fonction pour tirer une case vide d'une partie (-1 si la grille est pleine)
+static int tirer_case_libre_lot(lot_snake* lot, int i) {
+    if (lot->nb_libres[i] == 0) {
+        return -1;
+    }
+    int k = valeur_aleatoire(&lot->hasard[i], 0, lot->nb_libres[i] - 1);
+    return lot->cases_libres[(size_t)i * nb_cases + k];
+}
+
+// fonction pour placer la nourriture d'une partie
+static void placer_nourriture_lot(lot_snake* lot, int i) {
+    int numero = tirer_case_libre_lot(lot, i);
+    lot->nourriture[i] = numero;
+    if (numero >= 0) {
+        occuper_case_lot(lot, i, numero, case_nourriture);
+    }
+}
+
+// fonction pour armer un minuteur de la partie i et avancer sa prochaine chance si besoin
+// (prochaine_echeance n'est jamais aprs le premier minuteur arm: un minuteur arrt
+// peut seulement faire parcourir la roue pour rien, une fois)
+static void armer_minuteur_lot(lot_snake* lot, int i, int numero, int echeance) {
+    armer_minuteur(&lot->roues[i], numero, echeance);
+    if (echeance < lot->prochaine_echeance[i]) {
+        lot->prochaine_echeance[i] = echeance;
+    }
+}
+
+// fonction pour recalculer la prochaine chance de la partie i (le plus proche minuteur arm)
+static void recalculer_echeance_lot(lot_snake* lot, int i) {
+    const roue_minuteurs* roue = &lot->roues[i];
+    int32_t prochaine = aucune_echeance;
+    for (int k = 0; k < nb_minuteurs; k++) {
+        int32_t echeance = roue->minuteurs[k].echeance;
+        if (echeance >= 0 && echeance < prochaine) prochaine = echeance;
+    }
+    lot->prochaine_echeance[i] = prochaine;
+}
+
+// fonction pour placer un fruit bonus d'une partie (-1 si la rserve ou la grille est pleine)
+static int placer_fruit_bonus_lot(lot_snake* lot, int i) {
+    fruit* fruits = lot->fruits + (size_t)i * nb_fruits_max;
+    int k = 0;
+    while (k < nb_fruits_max && fruits[k].actif) k++;
+    if (k == nb_fruits_max) {
+        return -1;
+    }
+    fruits[k].type = valeur_aleatoire(&lot->hasard[i], fruit_bonus_score, fruit_bonus_taille);
+
+    int numero = tirer_case_libre_lot(lot, i);
+    if (numero < 0) {
+        return -1;
+    }
+    occuper_case_lot(lot, i, numero, case_fruit_bonus);
+    fruits[k].pos.x = numero % largeur_jeu;
+    fruits[k].pos.y = numero / largeur_jeu;
+    fruits[k].actif = 1;
+    armer_minuteur_lot(lot, i, minuteur_fruits + k, lot->nb_pas[i] + duree_fruit_bonus);
+    return k;
+}
+
+// fonction pour relancer la partie i avec une graine (comme initialiser_jeu)
+void reinitialiser_partie_lot(lot_snake* lot, int i, uint64_t graine) {
+    int32_t* corps = lot->corps + (size_t)i * nb_cases;
+    int32_t* libres = lot->cases_libres + (size_t)i * nb_cases;
+    int32_t* indices = lot->indice_libre + (size_t)i * nb_cases;
+
+    initialiser_generateur(&lot->hasard[i], graine);
+
+    // le serpent au milieu: la queue  gauche, la tte  droite
+    memset(corps, 0, nb_cases * sizeof(int32_t));
+    for (int k = 0; k < 3; k++) {
+        corps[k] = (hauteur_jeu / 2) * largeur_jeu + largeur_jeu / 2 - 2 + k;
+    }
+    lot->indice_queue[i] = 0;
+    lot->indice_tete[i] = 2;
+    lot->longueur[i] = 3;
+    lot->croissance[i] = 0;
+    lot->tete_x[i] = largeur_jeu / 2;
+    lot->tete_y[i] = hauteur_jeu / 2;
+
+    // toutes les cases vides puis les trois cases du serpent
+    memset(lot->grille + (size_t)i * nb_cases, case_vide, nb_cases);
+    for (int numero = 0; numero < nb_cases; numero++) {
+        libres[numero] = numero;
+        indices[numero] = numero;
+    }
+    lot->nb_libres[i] = nb_cases;
+    for (int k = 0; k < 3; k++) {
+        occuper_case_lot(lot, i, corps[k], case_serpent);
+    }
+
+    lot->dir[i] = dir_droite;
+    lot->score[i] = 0;
+    lot->game_over[i] = 0;
+    memset(lot->fruits + (size_t)i * nb_fruits_max, 0, nb_fruits_max * sizeof(fruit));
+    lot->dernier_bonus[i] = fruit_normal;
+    vider_roue(&lot->roues[i]);
+    lot->prochaine_echeance[i] = aucune_echeance;
+    lot->nb_pas[i] = 0;
+
+    placer_nourriture_lot(lot, i);
+    armer_minuteur_lot(lot, i, minuteur_apparition,
+                       valeur_aleatoire(&lot->hasard[i], apparition_fruit_min, apparition_fruit_max));
+}
+
+// fonction pour crer un lot; la partie i commence avec la graine graine + i
+lot_snake* creer_lot(int nb_parties, uint64_t graine) {
+    lot_snake* lot = (lot_snake*)calloc(1, sizeof(lot_snake));
+    if (lot == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le lot\n");
+        return NULL;
+    }
+
+    size_t n = (size_t)nb_parties;
+    lot->nb_parties = nb_parties;
+    lot->reinitialisation_auto = 1;
+
+    int32_t** champs[] = {
+        &lot->tete_x, &lot->tete_y, &lot->dir, &lot->score, &lot->longueur, &lot->croissance,
+        &lot->game_over, &lot->evenements, &lot->nb_pas, &lot->cible_x, &lot->cible_y, &lot->mort,
+        &lot->nourriture, &lot->dernier_bonus, &lot->indice_tete,
+        &lot->indice_queue, &lot->nb_libres, &lot->fin_score, &lot->fin_longueur, &lot->fin_nb_pas,
+        &lot->aucune_action, &lot->prochaine_echeance, &lot->minuteurs_dus
+    };
+    int erreur = 0;
+    for (size_t k = 0; k < sizeof(champs) / sizeof(champs[0]); k++) {
+        *champs[k] = (int32_t*)calloc(n, sizeof(int32_t));
+        erreur |= *champs[k] == NULL;
+    }
+    lot->hasard = (generateur*)calloc(n, sizeof(generateur));
+    lot->roues = (roue_minuteurs*)calloc(n, sizeof(roue_minuteurs));
+    lot->fruits = (fruit*)calloc(n * nb_fruits_max, sizeof(fruit));
+    lot->corps = (int32_t*)calloc(n * nb_cases, sizeof(int32_t));
+    lot->grille = (unsigned char*)calloc(n * nb_cases, 1);
+    lot->cases_libres = (int32_t*)calloc(n * nb_cases, sizeof(int32_t));
+    lot->indice_libre = (int32_t*)calloc(n * nb_cases, sizeof(int32_t));
+    erreur |= lot->hasard == NULL || lot->roues == NULL || lot->fruits == NULL || lot->corps == NULL || lot->grille == NULL ||
+              lot->cases_libres == NULL || lot->indice_libre == NULL;
+
+    if (erreur) {
+        printf("erreur: impossible d'allouer de la mmoire pour le lot\n");
+        detruire_lot(lot);
+        return NULL;
+    }
+
+    for (int i = 0; i < nb_parties; i++) {
+        lot->aucune_action[i] = -1;
+        reinitialiser_partie_lot(lot, i, graine + i);
+    }
+    lot->graine_suivante = graine + nb_parties;
+
+    return lot;
+}
+
+// fonction pour librer un lot
+void detruire_lot(lot_snake* lot) {
+    if (lot == NULL) return;
+
+    int32_t* champs[] = {
+        lot->tete_x, lot->tete_y, lot->dir, lot->score, lot->longueur, lot->croissance,
+        lot->game_over, lot->evenements, lot->nb_pas, lot->cible_x, lot->cible_y, lot->mort,
+        lot->nourriture, lot->dernier_bonus, lot->indice_tete,
+        lot->indice_queue, lot->nb_libres, lot->fin_score, lot->fin_longueur, lot->fin_nb_pas,
+        lot->aucune_action, lot->prochaine_echeance, lot->minuteurs_dus
+    };
+    for (size_t k = 0; k < sizeof(champs) / sizeof(champs[0]); k++) {
+        free(champs[k]);
+    }
+    free(lot->hasard);
+    free(lot->roues);
+    free(lot->fruits);
+    free(lot->corps);
+    free(lot->grille);
+    free(lot->cases_libres);
+    free(lot->indice_libre);
+    free(lot);
+}
+
+// tape vectorise: appliquer les actions, calculer la case vise et tester les murs
+// (tableaux en paramtres restrict pour que le compilateur sache qu'ils sont distincts)
+static void calculer_cibles(int n, const int32_t* restrict actions, int32_t* restrict dir,
+                            const int32_t* restrict tete_x, const int32_t* restrict tete_y,
+                            int32_t* restrict cible_x, int32_t* restrict cible_y,
+                            const int32_t* restrict game_over, int32_t* restrict mort,
+                            int32_t* restrict evenements) {
+    for (int i = 0; i < n; i++) {
+        int32_t d = dir[i];
+        int32_t a = actions[i];
+        // on ignore les actions ngatives et les demi-tours
+        // (haut/bas et gauche/droite ne diffrent que du bit 0)
+        d = (a < 0 || (a ^ d) == 1) ? d : a;
+        dir[i] = d;
+
+        int32_t x = tete_x[i] + (d == dir_droite) - (d == dir_gauche);
+        int32_t y = tete_y[i] + (d == dir_bas) - (d == dir_haut);
+        cible_x[i] = x;
+        cible_y[i] = y;
+
+        int32_t hors = (x < 0) | (x >= largeur_jeu) | (y < 0) | (y >= hauteur_jeu);
+        mort[i] = (game_over[i] == 0) & hors;
+        evenements[i] = 0;
+    }
+}
+
+// tape vectorise: reprer les parties dont un minuteur arrive  chance pendant ce pas
+// (seules celles-l parcourent leur roue; les autres ne lisent que deux entiers)
+static void reperer_minuteurs_dus(int n, const int32_t* restrict nb_pas, const int32_t* restrict prochaine_echeance,
+                                  const int32_t* restrict game_over, const int32_t* restrict mort,
+                                  int32_t* restrict dus) {
+    for (int i = 0; i < n; i++) {
+        dus[i] = (nb_pas[i] >= prochaine_echeance[i]) & (game_over[i] == 0) & (mort[i] == 0);
+    }
+}
+
+// fonction pour faire avancer toutes les parties d'un pas
+int avancer_lot(lot_snake* lot, const int32_t* actions) {
+    double debut = horloge_secondes();
+    int n = lot->nb_parties;
+    int terminees = 0;
+
+    // tape 1 (vectorise): directions, cases vises et murs
+    if (actions == NULL) {
+        actions = lot->aucune_action;  // garder la direction actuelle
+    }
+    calculer_cibles(n, actions, lot->dir, lot->tete_x, lot->tete_y, lot->cible_x, lot->cible_y,
+                    lot->game_over, lot->mort, lot->evenements);
+
+    // tape 2 (partie par partie): collision avec le corps, dplacement et repas
+    for (int i = 0; i < n; i++) {
+        if (lot->game_over[i]) continue;
+        if (lot->mort[i]) {
+            lot->mort[i] = evenement_mort_mur;
+            continue;
+        }
+
+        int numero = lot->cible_y[i] * largeur_jeu + lot->cible_x[i];
+        unsigned char* grille = lot->grille + (size_t)i * nb_cases;
+        int contenu = grille[numero];
+
+        // la queue n'a pas encore boug: elle compte comme un obstacle
+        if (contenu == case_serpent) {
+            lot->mort[i] = evenement_mort_serpent;
+            continue;
+        }
+        // le pas a lieu: les minuteurs de ce pas comptent  partir d'ici
+        lot->nb_pas[i]++;
+
+        // crire la nouvelle tte, avancer la queue sauf si le serpent grandit
+        int32_t* corps = lot->corps + (size_t)i * nb_cases;
+        int tete = (lot->indice_tete[i] + 1) % nb_cases;
+        lot->indice_tete[i] = tete;
+        corps[tete] = numero;
+        lot->tete_x[i] = lot->cible_x[i];
+        lot->tete_y[i] = lot->cible_y[i];
+        occuper_case_lot(lot, i, numero, case_serpent);
+
+        if (lot->croissance[i] > 0) {
+            lot->croissance[i]--;
+            lot->longueur[i]++;
+        } else {
+            liberer_case_lot(lot, i, corps[lot->indice_queue[i]]);
+            lot->indice_queue[i] = (lot->indice_queue[i] + 1) % nb_cases;
+        }
+
+        if (contenu == case_nourriture) {
+            lot->croissance[i]++;
+            placer_nourriture_lot(lot, i);
+            lot->score[i]++;
+            lot->evenements[i] |= evenement_mange;
+        }
+
+        if (contenu == case_fruit_bonus) {
+            fruit* fruits = lot->fruits + (size_t)i * nb_fruits_max;
+            int k = 0;
+            while (!fruits[k].actif || fruits[k].pos.x != lot->cible_x[i] || fruits[k].pos.y != lot->cible_y[i]) k++;
+            lot->evenements[i] |= evenement_bonus;
+            switch (fruits[k].type) {
+                case fruit_normal:
+                    lot->croissance[i]++;
+                    lot->score[i]++;
+                    break;
+                case fruit_bonus_score:
+                    lot->score[i] += 5;
+                    break;
+                case fruit_bonus_vitesse:
+                    armer_minuteur_lot(lot, i, minuteur_vitesse, lot->nb_pas[i] + duree_bonus_vitesse);
+                    lot->evenements[i] |= evenement_vitesse_debut;
+                    break;
+                case fruit_bonus_taille:
+                    lot->croissance[i] += 3;
+                    break;
+                default:
+                    break;
+            }
+            fruits[k].actif = 0;
+            lot->dernier_bonus[i] = fruits[k].type;
+            arreter_minuteur(&lot->roues[i], minuteur_fruits + k);
+        }
+    }
+
+    // tape 3: minuteurs arrivs  chance
+    // (vectorise: comparer nb_pas  la prochaine chance; puis partie par partie,
+    // seulement pour les parties repres: la plupart n'ont rien  faire  ce pas)
+    reperer_minuteurs_dus(n, lot->nb_pas, lot->prochaine_echeance, lot->game_over, lot->mort, lot->minuteurs_dus);
+    for (int i = 0; i < n; i++) {
+        if (!lot->minuteurs_dus[i]) continue;
+        roue_minuteurs* roue = &lot->roues[i];
+        int maintenant = lot->nb_pas[i];
+
+        int numero;
+        while ((numero = minuteur_echu(roue, maintenant)) >= 0) {
+            if (numero == minuteur_apparition) {
+                if (placer_fruit_bonus_lot(lot, i) >= 0) {
+                    lot->evenements[i] |= evenement_bonus_apparu;
+                }
+                armer_minuteur(roue, minuteur_apparition,
+                               maintenant + valeur_aleatoire(&lot->hasard[i], apparition_fruit_min, apparition_fruit_max));
+            } else if (numero == minuteur_vitesse) {
+                lot->evenements[i] |= evenement_vitesse_fin;
+            } else {
+                fruit* f = &lot->fruits[(size_t)i * nb_fruits_max + numero - minuteur_fruits];
+                f->actif = 0;
+                liberer_case_lot(lot, i, f->pos.y * largeur_jeu + f->pos.x);
+                lot->evenements[i] |= evenement_bonus_disparu;
+            }
+        }
+        recalculer_echeance_lot(lot, i);
+    }
+
+    // tape 4: noter les parties perdues et les relancer
+    for (int i = 0; i < n; i++) {
+        if (!lot->mort[i]) continue;
+
+        lot->evenements[i] = lot->mort[i];
+        lot->fin_score[i] = lot->score[i];
+        lot->fin_longueur[i] = lot->longueur[i] + lot->croissance[i];
+        lot->fin_nb_pas[i] = lot->nb_pas[i];
+        lot->game_over[i] = 1;
+        terminees++;
+
+        if (lot->reinitialisation_auto) {
+            reinitialiser_partie_lot(lot, i, lot->graine_suivante++);
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        lot->pas_total += !lot->game_over[i] || lot->mort[i];
+    }
+    lot->parties_terminees += terminees;
+    lot->secondes += horloge_secondes() - debut;
+
+    return terminees;
+}
+
+// fonction pour copier la partie i du lot dans un jeu_snake
+// le jeu doit avoir les dimensions par dfaut (cr par initialiser_jeu)
+int extraire_partie_lot(const lot_snake* lot, int i, jeu_snake* jeu) {
+    const int32_t* corps = lot->corps + (size_t)i * nb_cases;
+    const unsigned char* grille = lot->grille + (size_t)i * nb_cases;
+    const int32_t* libres = lot->cases_libres + (size_t)i * nb_cases;
+
+    if (jeu->largeur != largeur_jeu || jeu->hauteur != hauteur_jeu) {
+        printf("erreur: le jeu n'a pas les dimensions du lot\n");
+        return 1;
+    }
+
+    // corps: segments recopis de la queue  la tte au dbut du tampon
+    int longueur = lot->longueur[i];
+    if (reserver_corps(jeu, longueur) != 0) {
+        return 1;
+    }
+    for (int k = 0; k < longueur; k++) {
+        int numero = corps[(lot->indice_queue[i] + k) % nb_cases];
+        jeu->corps[k].x = numero % largeur_jeu;
+        jeu->corps[k].y = numero / largeur_jeu;
+    }
+    jeu->indice_queue = 0;
+    jeu->indice_tete = longueur - 1;
+    jeu->longueur = longueur;
+    jeu->croissance = lot->croissance[i];
+
+    // cases et listes des cases vides: la liste du lot est rpartie entre les blocs
+    // dans son ordre (identique au moteur tant que le plateau tient dans un bloc)
+    for (int b = 0; b < jeu->largeur_blocs * jeu->hauteur_blocs; b++) {
+        bloc_plateau* bloc = bloc_alloue(jeu, b);
+        memset(bloc->place, 0xff, sizeof(bloc->place));
+        bloc->nb_libres = 0;
+    }
+    for (int numero = 0; numero < nb_cases; numero++) {
+        int x = numero % largeur_jeu;
+        int y = numero / largeur_jeu;
+        jeu->blocs[(y / cote_bloc) * jeu->largeur_blocs + x / cote_bloc]->cases[(y % cote_bloc) * cote_bloc + x % cote_bloc] = grille[numero];
+    }
+    for (int k = 0; k < lot->nb_libres[i]; k++) {
+        int x = libres[k] % largeur_jeu;
+        int y = libres[k] / largeur_jeu;
+        bloc_plateau* bloc = jeu->blocs[(y / cote_bloc) * jeu->largeur_blocs + x / cote_bloc];
+        int locale = (y % cote_bloc) * cote_bloc + x % cote_bloc;
+        bloc->place[locale] = (uint16_t)bloc->nb_libres;
+        bloc->libres[bloc->nb_libres++] = (uint16_t)locale;
+    }
+    recalculer_libres(jeu);
+
+    jeu->dir_actuelle = lot->dir[i];
+    if (lot->nourriture[i] >= 0) {
+        jeu->nourriture.x = lot->nourriture[i] % largeur_jeu;
+        jeu->nourriture.y = lot->nourriture[i] / largeur_jeu;
+    } else {
+        jeu->nourriture.x = -1;
+        jeu->nourriture.y = -1;
+    }
+    memcpy(jeu->fruits, lot->fruits + (size_t)i * nb_fruits_max, sizeof(jeu->fruits));
+    jeu->dernier_bonus = lot->dernier_bonus[i];
+    jeu->minuteurs = lot->roues[i];
+    jeu->score = lot->score[i];
+    jeu->game_over = lot->game_over[i];
+    jeu->nb_pas = lot->nb_pas[i];
+    jeu->vitesse_normale = vitesse_normale_defaut;
+    jeu->vitesse_rapide = vitesse_bonus;
+    jeu->en_pause = 0;
+    jeu->en_menu = 0;
+    jeu->hasard = lot->hasard[i];
+    return 0;
+}
+
+// fonction pour connatre le dbit du lot en pas de partie par seconde
+double debit_lot(const lot_snake* lot) {
+    return lot->secondes > 0 ? lot->pas_total / lot->secondes : 0;
+}
+
+// fonction pour vrifier que le lot suit exactement les rgles de deplacer_serpent
+int comparer_lot_moteur(int nb_parties, int nb_pas, uint64_t graine) {
+    lot_snake* lot = creer_lot(nb_parties, graine);
+    jeu_snake** jeux = (jeu_snake**)calloc(nb_parties, sizeof(jeu_snake*));
+    int32_t* actions = (int32_t*)malloc(nb_parties * sizeof(int32_t));
+    jeu_snake* copie = initialiser_jeu(0);
+    uint64_t graine_suivante = graine + nb_parties;
+    generateur joueur;
+    int differences = 0;
+
+    if (lot == NULL || jeux == NULL || actions == NULL || copie == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour la comparaison\n");
+        differences = -1;
+        nb_pas = 0;
+    }
+
+    // les mmes graines que le lot, partie par partie
+    for (int i = 0; i < nb_parties && differences == 0; i++) {
+        jeux[i] = initialiser_jeu(graine + i);
+        if (jeux[i] == NULL) {
+            differences = -1;
+        }
+    }
+
+    // des actions au hasard, souvent sans changement pour laisser les serpents grandir
+    initialiser_generateur(&joueur, graine ^ 0x5eed);
+    for (int pas = 0; pas < nb_pas && differences == 0; pas++) {
+        for (int i = 0; i < nb_parties; i++) {
+            int tirage = valeur_aleatoire(&joueur, 0, 7);
+            actions[i] = tirage < 4 ? tirage : -1;
+
+            // mme rgle que dans main: pas de demi-tour
+            if (actions[i] >= 0 && (actions[i] ^ jeux[i]->dir_actuelle) != 1) {
+                jeux[i]->dir_actuelle = actions[i];
+            }
+        }
+
+        avancer_lot(lot, actions);
+
+        for (int i = 0; i < nb_parties && differences >= 0; i++) {
+            if (deplacer_serpent(jeux[i]) != lot->evenements[i]) {
+                differences++;
+            }
+
+            // une partie perdue est relance avec la graine suivante, comme dans le lot
+            if (jeux[i]->game_over) {
+                detruire_jeu(jeux[i]);
+                jeux[i] = initialiser_jeu(graine_suivante++);
+                if (jeux[i] == NULL) {
+                    differences = -1;
+                    break;
+                }
+            }
+
+            if (extraire_partie_lot(lot, i, copie) != 0) {
+                differences = -1;
+                break;
+            }
+            copie->en_menu = jeux[i]->en_menu;
+            if (!jeux_identiques(copie, jeux[i])) {
+                differences++;
+            }
+        }
+    }
+
+    if (jeux != NULL) {
+        for (int i = 0; i < nb_parties; i++) {
+            detruire_jeu(jeux[i]);
+        }
+    }
+    free(jeux);
+    free(actions);
+    detruire_jeu(copie);
+    detruire_lot(lot);
+    return differences;
+}
@@ -0,0 +1,86 @@
+// simulateur par lots: fait avancer des milliers de parties  la fois
+// les champs lus  chaque pas sont rangs en tableaux (un tableau par champ)
+// pour que le compilateur puisse vectoriser les boucles (compiler avec -O3)
+// les rgles sont exactement celles de deplacer_serpent dans snake_moteur.c
+// (toutes les parties utilisent le plateau par dfaut, largeur_jeu x hauteur_jeu, sans niveau)
+#ifndef SNAKE_LOT_H
+#define SNAKE_LOT_H
+
+#include "snake_moteur.h"
+
+#define aucune_echeance 0x7fffffff  // prochaine_echeance d'une partie sans minuteur arm
+
+// structure d'un lot de parties (structure de tableaux)
+typedef struct {
+    int nb_parties;                 // nombre de parties du lot
+    int reinitialisation_auto;      // relancer une partie ds qu'elle est perdue
+    uint64_t graine_suivante;       // graine de la prochaine partie relance
+
+    // champs parcourus  chaque pas: un tableau de nb_parties entiers par champ
+    int32_t* tete_x;                // position de la tte
+    int32_t* tete_y;
+    int32_t* dir;                   // direction actuelle (direction)
+    int32_t* score;
+    int32_t* longueur;              // nombre de segments
+    int32_t* croissance;            // segments  ajouter
+    int32_t* game_over;             // partie termine (en attente de relance)
+    int32_t* evenements;            // vnements du dernier pas (evenement)
+    int32_t* nb_pas;                // pas jous dans la partie en cours
+
+    // tableaux de travail du pas en cours
+    int32_t* cible_x;               // case vise par la tte
+    int32_t* cible_y;
+    int32_t* mort;                  // cause de la mort pendant ce pas (0 si vivant)
+    int32_t* aucune_action;         // actions  -1, utilises quand aucune n'est donne
+    int32_t* minuteurs_dus;         // partie dont un minuteur peut arriver  chance  ce pas
+    int32_t* prochaine_echeance;    // pas du plus proche minuteur arm (au plus tt), aucune_echeance si aucun
+
+    // champs consults seulement quand quelque chose se passe
+    int32_t* nourriture;            // numro de la case de la nourriture (-1 si aucune)
+    int32_t* dernier_bonus;         // type du dernier fruit bonus mang (type_fruit)
+    int32_t* indice_tete;           // tampon circulaire du corps
+    int32_t* indice_queue;
+    int32_t* nb_libres;             // nombre de cases vides
+    generateur* hasard;             // gnrateur de chaque partie
+    roue_minuteurs* roues;          // minuteurs de chaque partie (fruits, bonus de vitesse),
+                                    // parcourus seulement quand prochaine_echeance est atteinte
+    fruit* fruits;                  // rserve de fruits bonus: nb_fruits_max par partie
+
+    // tat de chaque partie: nb_cases valeurs conscutives par partie
+    int32_t* corps;                 // numros des cases du corps (tampon circulaire)
+    unsigned char* grille;          // contenu des cases (contenu_case)
+    int32_t* cases_libres;          // liste compacte des cases vides
+    int32_t* indice_libre;          // place de chaque case dans cases_libres (-1 si occupe)
+
+    // rsultat des parties termines pendant le dernier pas
+    int32_t* fin_score;
+    int32_t* fin_longueur;
+    int32_t* fin_nb_pas;
+
+    // compteurs pour mesurer le dbit
+    long long pas_total;            // pas de partie jous (parties x pas)
+    long long parties_terminees;
+    double secondes;                // temps pass dans avancer_lot
+} lot_snake;
+
+// cration et destruction
+lot_snake* creer_lot(int nb_parties, uint64_t graine);
+void detruire_lot(lot_snake* lot);
+void reinitialiser_partie_lot(lot_snake* lot, int i, uint64_t graine);
+
+// un pas pour toutes les parties; actions peut tre NULL (garder la direction)
+// retourne le nombre de parties termines pendant ce pas
+int avancer_lot(lot_snake* lot, const int32_t* actions);
+
+// copie la partie i du lot dans un jeu_snake cr par initialiser_jeu (pour l'afficher ou la comparer)
+// retourne 0 si tout s'est bien pass
+int extraire_partie_lot(const lot_snake* lot, int i, jeu_snake* jeu);
+
+// mesures
+double debit_lot(const lot_snake* lot);   // pas de partie par seconde
+
+// compare le lot aux rgles de snake_moteur.c sur des parties alatoires
+// retourne le nombre de diffrences trouves (0 si identique)
+int comparer_lot_moteur(int nb_parties, int nb_pas, uint64_t graine);
+
+#endif
@@ -0,0 +1,920 @@
+// rgles du jeu du serpent, indpendantes de raylib
+#include "snake_moteur.h"
+#include "snake_profil.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// nombre d'allocations faites par le moteur depuis le lancement
+static _Atomic long long nb_allocations = 0;
+
+// fonctions pour allouer la mmoire du moteur en comptant les allocations
+static void* allouer(size_t taille) {
+    nb_allocations++;
+    return malloc(taille);
+}
+
+static void* allouer_zero(size_t nombre, size_t taille) {
+    nb_allocations++;
+    return calloc(nombre, taille);
+}
+
+// fonction pour connatre le nombre d'allocations du moteur depuis le lancement
+long long allocations_moteur(void) {
+    return nb_allocations;
+}
+
+// fonction pour obtenir la position du i-me segment (0 = la tte)
+position* segment_serpent(jeu_snake* jeu, int i) {
+    return &jeu->corps[(jeu->indice_tete - i) & (jeu->capacite_corps - 1)];
+}
+
+// fonction pour obtenir le numro du bloc qui contient une case
+static int numero_bloc(const jeu_snake* jeu, int x, int y) {
+    return (y / cote_bloc) * jeu->largeur_blocs + x / cote_bloc;
+}
+
+// fonction pour obtenir le numro d'une case  l'intrieur de son bloc
+static int numero_dans_bloc(int x, int y) {
+    return (y % cote_bloc) * cote_bloc + x % cote_bloc;
+}
+
+// fonctions pour connatre le nombre de cases du plateau dans un bloc
+// (les blocs du bord droit et du bas peuvent dpasser du plateau)
+static int largeur_bloc(const jeu_snake* jeu, int bloc) {
+    int reste = jeu->largeur - (bloc % jeu->largeur_blocs) * cote_bloc;
+    return reste < cote_bloc ? reste : cote_bloc;
+}
+
+static int hauteur_bloc(const jeu_snake* jeu, int bloc) {
+    int reste = jeu->hauteur - (bloc / jeu->largeur_blocs) * cote_bloc;
+    return reste < cote_bloc ? reste : cote_bloc;
+}
+
+// fonction pour modifier le nombre de cases vides d'un bloc dans l'arbre
+static void ajuster_arbre(jeu_snake* jeu, int bloc, int difference) {
+    int nb_blocs = jeu->largeur_blocs * jeu->hauteur_blocs;
+    for (int i = bloc + 1; i <= nb_blocs; i += i & -i) {
+        jeu->arbre_libres[i] += difference;
+    }
+}
+
+// fonction pour trouver le bloc qui contient la case vide de rang donn
+// (le rang devient celui de la case dans la liste du bloc)
+static int chercher_bloc(const jeu_snake* jeu, int* rang) {
+    int nb_blocs = jeu->largeur_blocs * jeu->hauteur_blocs;
+    int pas = 1;
+    while (pas * 2 <= nb_blocs) pas *= 2;
+
+    int bloc = 0;
+    for (; pas > 0; pas /= 2) {
+        if (bloc + pas <= nb_blocs && jeu->arbre_libres[bloc + pas] <= *rang) {
+            bloc += pas;
+            *rang -= jeu->arbre_libres[bloc];
+        }
+    }
+    return bloc;
+}
+
+// fonction pour remettre un bloc dans l'tat d'un bloc jamais occup
+// (toutes ses cases vides, ranges dans l'ordre des lignes)
+static void remplir_bloc_vide(const jeu_snake* jeu, bloc_plateau* contenu, int bloc) {
+    memset(contenu->cases, case_vide, sizeof(contenu->cases));
+    memset(contenu->place, 0xff, sizeof(contenu->place));  // aucune_place
+    int largeur = largeur_bloc(jeu, bloc);
+    int hauteur = hauteur_bloc(jeu, bloc);
+    contenu->nb_libres = 0;
+    for (int y = 0; y < hauteur; y++) {
+        for (int x = 0; x < largeur; x++) {
+            contenu->place[y * cote_bloc + x] = (uint16_t)contenu->nb_libres;
+            contenu->libres[contenu->nb_libres++] = (uint16_t)(y * cote_bloc + x);
+        }
+    }
+}
+
+// fonction pour obtenir un bloc en l'allouant s'il n'existe pas encore
+// (toutes ses cases sont alors vides, ranges dans l'ordre des lignes)
+// aprs reserver_jeu, le bloc est pris dans la zone rserve, sans allocation
+// retourne NULL si la mmoire manque
+bloc_plateau* bloc_alloue(jeu_snake* jeu, int bloc) {
+    if (jeu->blocs[bloc] != NULL) {
+        return jeu->blocs[bloc];
+    }
+
+    bloc_plateau* nouveau = jeu->zone_blocs != NULL ? &jeu->zone_blocs[bloc]
+                                                     : (bloc_plateau*)allouer(sizeof(bloc_plateau));
+    if (nouveau == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le plateau\n");
+        return NULL;
+    }
+    remplir_bloc_vide(jeu, nouveau, bloc);
+
+    jeu->blocs[bloc] = nouveau;
+    return nouveau;
+}
+
+// fonction pour vider un bloc sans librer sa mmoire
+// (il quivaut ensuite  un bloc jamais allou; appeler recalculer_libres aprs)
+void vider_bloc(jeu_snake* jeu, int bloc) {
+    if (jeu->blocs[bloc] != NULL) {
+        remplir_bloc_vide(jeu, jeu->blocs[bloc], bloc);
+    }
+}
+
+// fonction pour lire le contenu d'une case
+contenu_case lire_case(const jeu_snake* jeu, int x, int y) {
+    const bloc_plateau* bloc = jeu->blocs[numero_bloc(jeu, x, y)];
+    return bloc == NULL ? case_vide : (contenu_case)bloc->cases[numero_dans_bloc(x, y)];
+}
+
+// fonction pour marquer une case comme occupe
+// retourne 0 si tout s'est bien pass, 1 si le bloc de la case n'a pas pu tre allou
+int occuper_case(jeu_snake* jeu, int x, int y, contenu_case contenu) {
+    int numero = numero_bloc(jeu, x, y);
+    bloc_plateau* bloc = bloc_alloue(jeu, numero);
+    if (bloc == NULL) {
+        return 1;
+    }
+    int locale = numero_dans_bloc(x, y);
+    int place = bloc->place[locale];
+
+    // retirer la case de la liste des cases vides en la remplaant par la dernire
+    if (place != aucune_place) {
+        uint16_t derniere = bloc->libres[--bloc->nb_libres];
+        bloc->libres[place] = derniere;
+        bloc->place[derniere] = (uint16_t)place;
+        bloc->place[locale] = aucune_place;
+        jeu->nb_libres--;
+        ajuster_arbre(jeu, numero, -1);
+    }
+
+    bloc->cases[locale] = contenu;
+    return 0;
+}
+
+// fonction pour marquer une case comme vide
+void liberer_case(jeu_snake* jeu, int x, int y) {
+    int numero = numero_bloc(jeu, x, y);
+    bloc_plateau* bloc = jeu->blocs[numero];
+    if (bloc == NULL) return;  // bloc jamais occup: la case est dj vide
+    int locale = numero_dans_bloc(x, y);
+
+    // remettre la case  la fin de la liste des cases vides
+    if (bloc->place[locale] == aucune_place) {
+        bloc->place[locale] = (uint16_t)bloc->nb_libres;
+        bloc->libres[bloc->nb_libres++] = (uint16_t)locale;
+        jeu->nb_libres++;
+        ajuster_arbre(jeu, numero, 1);
+    }
+
+    bloc->cases[locale] = case_vide;
+}
+
+// fonction pour recompter les cases vides aprs une modification directe des blocs
+void recalculer_libres(jeu_snake* jeu) {
+    int nb_blocs = jeu->largeur_blocs * jeu->hauteur_blocs;
+    memset(jeu->arbre_libres, 0, (nb_blocs + 1) * sizeof(int));
+    jeu->nb_libres = 0;
+
+    for (int i = 1; i <= nb_blocs; i++) {
+        int libres = jeu->blocs[i - 1] != NULL ? jeu->blocs[i - 1]->nb_libres
+                                               : largeur_bloc(jeu, i - 1) * hauteur_bloc(jeu, i - 1);
+        jeu->nb_libres += libres;
+        jeu->arbre_libres[i] += libres;
+        int parent = i + (i & -i);
+        if (parent <= nb_blocs) {
+            jeu->arbre_libres[parent] += jeu->arbre_libres[i];
+        }
+    }
+}
+
+// fonction pour agrandir le tampon du corps jusqu' au moins longueur segments
+// les segments sont recopis dans l'ordre, de la queue  la tte
+// retourne 0 si tout s'est bien pass
+int reserver_corps(jeu_snake* jeu, int longueur) {
+    if (jeu->capacite_corps >= longueur) {
+        return 0;
+    }
+
+    int capacite = jeu->capacite_corps;
+    while (capacite < longueur) capacite *= 2;
+    position* corps = (position*)allouer(capacite * sizeof(position));
+    if (corps == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le serpent\n");
+        return 1;
+    }
+
+    for (int i = 0; i < jeu->longueur; i++) {
+        corps[i] = *segment_serpent(jeu, jeu->longueur - 1 - i);
+    }
+    free(jeu->corps);
+    jeu->corps = corps;
+    jeu->capacite_corps = capacite;
+    jeu->indice_queue = 0;
+    jeu->indice_tete = jeu->longueur - 1;
+    return 0;
+}
+
+// fonction pour initialiser le gnrateur pseudo-alatoire  partir d'une graine
+void initialiser_generateur(generateur* gen, uint64_t graine) {
+    gen->etat = 0;
+    gen->increment = (graine << 1) | 1;  // l'incrment doit tre impair
+    valeur_aleatoire(gen, 0, 0);
+    gen->etat += graine;
+    valeur_aleatoire(gen, 0, 0);
+}
+
+// fonction pour tirer un nombre entre min et max inclus (remplace GetRandomValue)
+int valeur_aleatoire(generateur* gen, int min, int max) {
+    // avancer l'tat puis mlanger ses bits (pcg32)
+    uint64_t ancien = gen->etat;
+    gen->etat = ancien * 6364136223846793005ULL + gen->increment;
+    uint32_t melange = (uint32_t)(((ancien >> 18) ^ ancien) >> 27);
+    uint32_t rotation = (uint32_t)(ancien >> 59);
+    uint32_t tirage = (melange >> rotation) | (melange << ((32 - rotation) & 31));
+
+    // ramener le tirage dans l'intervalle demand
+    uint32_t etendue = (uint32_t)(max - min) + 1;
+    return min + (int)(((uint64_t)tirage * etendue) >> 32);
+}
+
+// fonction pour arrter tous les minuteurs d'une roue
+void vider_roue(roue_minuteurs* roue) {
+    for (int i = 0; i < taille_roue; i++) {
+        roue->cases[i] = -1;
+    }
+    for (int i = 0; i < nb_minuteurs; i++) {
+        roue->minuteurs[i].echeance = -1;
+        roue->minuteurs[i].suivant = -1;
+        roue->minuteurs[i].precedent = -1;
+    }
+}
+
+// fonction pour arrter un minuteur (sans effet s'il l'est dj)
+void arreter_minuteur(roue_minuteurs* roue, int numero) {
+    minuteur* m = &roue->minuteurs[numero];
+    if (m->echeance < 0) return;
+
+    // le retirer de la liste de sa case
+    if (m->precedent >= 0) {
+        roue->minuteurs[m->precedent].suivant = m->suivant;
+    } else {
+        roue->cases[m->echeance & (taille_roue - 1)] = m->suivant;
+    }
+    if (m->suivant >= 0) {
+        roue->minuteurs[m->suivant].precedent = m->precedent;
+    }
+    m->echeance = -1;
+    m->suivant = -1;
+    m->precedent = -1;
+}
+
+// fonction pour armer un minuteur: il se dclenchera au pas echeance
+// (une chance plus loin que taille_roue pas attend simplement un ou plusieurs tours)
+void armer_minuteur(roue_minuteurs* roue, int numero, int echeance) {
+    arreter_minuteur(roue, numero);
+
+    // le ranger en tte de la liste de sa case
+    minuteur* m = &roue->minuteurs[numero];
+    int16_t* premier = &roue->cases[echeance & (taille_roue - 1)];
+    m->echeance = echeance;
+    m->precedent = -1;
+    m->suivant = *premier;
+    if (*premier >= 0) {
+        roue->minuteurs[*premier].precedent = (int16_t)numero;
+    }
+    *premier = (int16_t)numero;
+}
+
+// fonction pour retirer de la roue un minuteur arriv  chance au pas maintenant
+// retourne son numro, ou -1 s'il n'y en a plus pour ce pas
+// (les minuteurs de la case qui attendent un autre tour restent en place)
+int minuteur_echu(roue_minuteurs* roue, int maintenant) {
+    for (int i = roue->cases[maintenant & (taille_roue - 1)]; i >= 0; i = roue->minuteurs[i].suivant) {
+        if (roue->minuteurs[i].echeance <= maintenant) {
+            arreter_minuteur(roue, i);
+            return i;
+        }
+    }
+    return -1;
+}
+
+// fonction pour initialiser le jeu sur le plateau par dfaut
+jeu_snake* initialiser_jeu(uint64_t graine) {
+    return creer_jeu(largeur_jeu, hauteur_jeu, graine);
+}
+
+// fonction pour librer les blocs d'un jeu (un par un, ou toute la zone rserve)
+static void liberer_blocs(jeu_snake* jeu) {
+    if (jeu->blocs != NULL && jeu->zone_blocs == NULL) {
+        for (int i = 0; i < jeu->largeur_blocs * jeu->hauteur_blocs; i++) {
+            free(jeu->blocs[i]);
+        }
+    }
+    free(jeu->zone_blocs);
+    jeu->zone_blocs = NULL;
+}
+
+// fonction pour rserver d'un coup toute la mmoire que la partie peut demander:
+// le corps  la taille du plateau et une zone qui contient tous les blocs
+// ensuite jouer, recommencer (reinitialiser_jeu) et copier une partie de mme taille
+// n'allouent plus rien; la rservation est perdue si le plateau change de taille
+// retourne 0 si tout s'est bien pass
+int reserver_jeu(jeu_snake* jeu) {
+    if (reserver_corps(jeu, jeu->largeur * jeu->hauteur) != 0) {
+        return 1;
+    }
+    if (jeu->zone_blocs != NULL) {
+        return 0;
+    }
+
+    int nb_blocs = jeu->largeur_blocs * jeu->hauteur_blocs;
+    bloc_plateau* zone = (bloc_plateau*)allouer((size_t)nb_blocs * sizeof(bloc_plateau));
+    if (zone == NULL) {
+        printf("erreur: impossible de rserver la mmoire du plateau\n");
+        return 1;
+    }
+
+    // les blocs dj allous passent dans la zone; les autres y attendent leur premire case
+    for (int i = 0; i < nb_blocs; i++) {
+        if (jeu->blocs[i] != NULL) {
+            memcpy(&zone[i], jeu->blocs[i], sizeof(bloc_plateau));
+            free(jeu->blocs[i]);
+            jeu->blocs[i] = &zone[i];
+        }
+    }
+    jeu->zone_blocs = zone;
+    return 0;
+}
+
+// fonction pour donner au jeu un plateau de largeur x hauteur cases
+// si les dimensions changent, les blocs sont librs et le plateau est  remplir
+// (recalculer_libres, copier_jeu ou restaurer_image); sinon rien ne change
+// retourne 0 si tout s'est bien pass
+int redimensionner_jeu(jeu_snake* jeu, int largeur, int hauteur) {
+    if (largeur < 5 || hauteur < 1 || (long long)largeur * hauteur > 1000000000) {
+        printf("erreur: taille de plateau impossible: %d x %d\n", largeur, hauteur);
+        return 1;
+    }
+    if (jeu->blocs != NULL && jeu->largeur == largeur && jeu->hauteur == hauteur) {
+        return 0;
+    }
+
+    liberer_blocs(jeu);
+    free(jeu->blocs);
+    free(jeu->arbre_libres);
+
+    // un niveau d'une autre taille ne peut plus tre pos sur ce plateau
+    if (jeu->niveau != NULL && (jeu->niveau->largeur != largeur || jeu->niveau->hauteur != hauteur)) {
+        jeu->niveau = NULL;
+    }
+    jeu->largeur = largeur;
+    jeu->hauteur = hauteur;
+    jeu->largeur_blocs = (largeur + cote_bloc - 1) / cote_bloc;
+    jeu->hauteur_blocs = (hauteur + cote_bloc - 1) / cote_bloc;
+    int nb_blocs = jeu->largeur_blocs * jeu->hauteur_blocs;
+    jeu->blocs = (bloc_plateau**)allouer_zero(nb_blocs, sizeof(bloc_plateau*));
+    jeu->arbre_libres = (int*)allouer_zero(nb_blocs + 1, sizeof(int));
+
+    if (jeu->blocs == NULL || jeu->arbre_libres == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le plateau\n");
+        free(jeu->blocs);
+        free(jeu->arbre_libres);
+        jeu->blocs = NULL;
+        jeu->arbre_libres = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+// fonction pour jouer les prochaines parties sur un niveau (NULL: plateau sans mur)
+// le plateau prend la taille du niveau; les murs sont poss par reinitialiser_jeu
+// le niveau n'est pas copi: il doit rester en mmoire tant que le jeu s'en sert
+// retourne 0 si tout s'est bien pass
+int choisir_niveau(jeu_snake* jeu, const niveau* niv) {
+    if (niv != NULL && redimensionner_jeu(jeu, niv->largeur, niv->hauteur) != 0) {
+        return 1;
+    }
+    jeu->niveau = niv;
+    return 0;
+}
+
+// fonction pour allouer un jeu dont l'tat reste  remplir
+// (par reinitialiser_jeu, copier_jeu ou restaurer_image)
+jeu_snake* allouer_jeu(int largeur, int hauteur) {
+    // mise  zro: deux parties de mme graine ont exactement le mme tat
+    jeu_snake* jeu = (jeu_snake*)allouer_zero(1, sizeof(jeu_snake));
+
+    if (jeu ==NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le jeu\n");
+        return NULL;
+    }
+
+    jeu->capacite_corps = 16;
+    jeu->corps = (position*)allouer_zero(jeu->capacite_corps, sizeof(position));
+    if (jeu->corps == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le jeu\n");
+        detruire_jeu(jeu);
+        return NULL;
+    }
+    if (redimensionner_jeu(jeu, largeur, hauteur) != 0) {
+        detruire_jeu(jeu);
+        return NULL;
+    }
+    return jeu;
+}
+
+// fonction pour crer un jeu sur un plateau de largeur x hauteur cases
+jeu_snake* creer_jeu(int largeur, int hauteur, uint64_t graine) {
+    jeu_snake* jeu = allouer_jeu(largeur, hauteur);
+    if (jeu != NULL) {
+        reinitialiser_jeu(jeu, graine);
+    }
+    return jeu;
+}
+
+// fonction pour recommencer une partie sans librer ni allouer de mmoire
+// l'tat obtenu est celui de creer_jeu avec la mme graine
+// (sans reserver_jeu, les blocs occups pour la premire fois sont allous:
+// si la mmoire manque, la partie est laisse termine, game_over  1)
+void reinitialiser_jeu(jeu_snake* jeu, uint64_t graine) {
+    // les blocs dj allous sont gards, vids
+    for (int i = 0; i < jeu->largeur_blocs * jeu->hauteur_blocs; i++) {
+        vider_bloc(jeu, i);
+    }
+
+    // le hasard de la partie ne dpend que de la graine
+    initialiser_generateur(&jeu->hasard, graine);
+
+    // crer le serpent au milieu de l'cran: la queue  gauche, la tte  droite
+    for (int i = 0; i < 3; i++) {
+        jeu->corps[i].x = jeu->largeur / 2 - 2 + i;
+        jeu->corps[i].y = jeu->hauteur / 2;
+    }
+    jeu->indice_queue = 0;
+    jeu->indice_tete = 2;
+    jeu->longueur = 3;
+    jeu->croissance = 0;
+
+    // au dpart toutes les cases sont vides, sauf les murs du niveau
+    recalculer_libres(jeu);
+    int erreur = 0;
+    if (jeu->niveau != NULL) {
+        for (int i = 0; i < jeu->niveau->nb_murs; i++) {
+            int numero = jeu->niveau->liste_murs[i];
+            erreur |= occuper_case(jeu, numero % jeu->largeur, numero / jeu->largeur, case_mur);
+        }
+    }
+    // puis le serpent occupe ses trois cases
+    for (int i = 0; i < 3; i++) {
+        erreur |= occuper_case(jeu, jeu->corps[i].x, jeu->corps[i].y, case_serpent);
+    }
+
+    // initialiser les autres paramtres du jeu
+    jeu->dir_actuelle = dir_droite;  // le serpent commence vers la droite
+    jeu->score = 0;
+    jeu->game_over = 0;
+    jeu->en_pause = 0;
+    jeu->en_menu = 1;  // commencer dans le menu
+    jeu->nb_pas = 0;
+
+    // initialiser les paramtres des fruits bonus
+    memset(jeu->fruits, 0, sizeof(jeu->fruits));
+    jeu->dernier_bonus = fruit_normal;
+    vider_roue(&jeu->minuteurs);
+    jeu->vitesse_normale = vitesse_normale_defaut;  // 10 pas par seconde
+    jeu->vitesse_rapide = vitesse_bonus;            // 15 pendant le bonus
+
+    // placer la premire nourriture sur une case libre
+    erreur |= placer_nourriture(jeu);
+
+    // le moment du premier fruit bonus est tir une seule fois, ds le dpart
+    armer_minuteur(&jeu->minuteurs, minuteur_apparition,
+                   valeur_aleatoire(&jeu->hasard, apparition_fruit_min, apparition_fruit_max));
+
+    // plus de mmoire pour le plateau: la partie ne peut pas tre joue
+    if (erreur) {
+        jeu->game_over = 1;
+    }
+}
+
+// fonction pour copier l'tat d'une partie dans une autre (pour explorer plusieurs suites)
+// la mmoire de la destination est rutilise quand le plateau a la mme taille
+// retourne 0 si tout s'est bien pass
+int copier_jeu(jeu_snake* destination, const jeu_snake* source) {
+    if (redimensionner_jeu(destination, source->largeur, source->hauteur) != 0 ||
+        reserver_corps(destination, source->capacite_corps) != 0) {
+        return 1;
+    }
+
+    // champs simples, sans toucher aux tampons de la destination
+    jeu_snake tampons = *destination;
+    *destination = *source;
+    destination->corps = tampons.corps;
+    destination->capacite_corps = tampons.capacite_corps;
+    destination->blocs = tampons.blocs;
+    destination->arbre_libres = tampons.arbre_libres;
+    destination->zone_blocs = tampons.zone_blocs;
+
+    // corps de la queue  la tte, en deux morceaux si le tampon de la source fait le tour
+    int premiers = source->capacite_corps - source->indice_queue;
+    if (premiers > source->longueur) premiers = source->longueur;
+    memcpy(destination->corps, source->corps + source->indice_queue, premiers * sizeof(position));
+    memcpy(destination->corps + premiers, source->corps, (source->longueur - premiers) * sizeof(position));
+    destination->indice_queue = 0;
+    destination->indice_tete = source->longueur - 1;
+
+    // blocs: seule la partie utile de la liste des cases vides est recopie
+    int nb_blocs = source->largeur_blocs * source->hauteur_blocs;
+    for (int i = 0; i < nb_blocs; i++) {
+        const bloc_plateau* bloc = source->blocs[i];
+        if (bloc == NULL) {
+            vider_bloc(destination, i);
+            continue;
+        }
+        bloc_plateau* copie = bloc_alloue(destination, i);
+        if (copie == NULL) {
+            return 1;
+        }
+        memcpy(copie->cases, bloc->cases, sizeof(bloc->cases));
+        memcpy(copie->place, bloc->place, sizeof(bloc->place));
+        memcpy(copie->libres, bloc->libres, bloc->nb_libres * sizeof(uint16_t));
+        copie->nb_libres = bloc->nb_libres;
+    }
+    memcpy(destination->arbre_libres, source->arbre_libres, (nb_blocs + 1) * sizeof(int));
+    return 0;
+}
+
+// fonction pour crer une copie indpendante d'une partie
+jeu_snake* cloner_jeu(const jeu_snake* source) {
+    jeu_snake* copie = allouer_jeu(source->largeur, source->hauteur);
+    if (copie != NULL && copier_jeu(copie, source) != 0) {
+        detruire_jeu(copie);
+        return NULL;
+    }
+    return copie;
+}
+
+// fonction pour vrifier si une position est occupe par le serpent
+int est_sur_serpent(jeu_snake* jeu, int x, int y) {
+    const bloc_plateau* bloc = jeu->blocs[numero_bloc(jeu, x, y)];
+    return bloc != NULL && bloc->cases[numero_dans_bloc(x, y)] == case_serpent;
+}
+
+// fonction pour tirer au hasard une case vide
+// retourne 0 si la grille est pleine
+int tirer_case_libre(jeu_snake* jeu, position* pos) {
+    if (jeu->nb_libres == 0) {
+        return 0;
+    }
+
+    // choisir le rang de la case parmi toutes les cases vides, puis son bloc
+    int rang = valeur_aleatoire(&jeu->hasard, 0, jeu->nb_libres - 1);
+    int numero = chercher_bloc(jeu, &rang);
+    const bloc_plateau* bloc = jeu->blocs[numero];
+
+    int x, y;
+    if (bloc != NULL) {
+        x = bloc->libres[rang] % cote_bloc;
+        y = bloc->libres[rang] / cote_bloc;
+    } else {
+        // bloc jamais occup: ses cases vides sont toutes ses cases, dans l'ordre
+        x = rang % largeur_bloc(jeu, numero);
+        y = rang / largeur_bloc(jeu, numero);
+    }
+    pos->x = (numero % jeu->largeur_blocs) * cote_bloc + x;
+    pos->y = (numero / jeu->largeur_blocs) * cote_bloc + y;
+    return 1;
+}
+
+// fonction pour placer une nouvelle nourriture
+// retourne 0 si tout s'est bien pass (mme sans case libre), 1 si la mmoire manque
+int placer_nourriture(jeu_snake* jeu) {
+    int erreur = 0;
+    PROFIL_DEBUT(profil_nourriture);
+
+    // choisir une case libre (pas sur le serpent ni sur le fruit bonus)
+    if (!tirer_case_libre(jeu, &jeu->nourriture) ||
+        (erreur = occuper_case(jeu, jeu->nourriture.x, jeu->nourriture.y, case_nourriture)) != 0) {
+        // plus aucune case libre (ou plus de mmoire pour sa case): pas de nourriture
+        jeu->nourriture.x = -1;
+        jeu->nourriture.y = -1;
+    }
+
+    PROFIL_FIN(profil_nourriture);
+    return erreur;
+}
+
+// fonction pour placer un fruit bonus dans un emplacement libre de la rserve
+// retourne le numro du fruit, ou -1 si la rserve ou le plateau est plein
+int placer_fruit_bonus(jeu_snake* jeu) {
+    int k = 0;
+    while (k < nb_fruits_max && jeu->fruits[k].actif) k++;
+    if (k == nb_fruits_max) {
+        return -1;
+    }
+    fruit* f = &jeu->fruits[k];
+
+    // choisir alatoirement un type de fruit bonus
+    f->type = valeur_aleatoire(&jeu->hasard, fruit_bonus_score, fruit_bonus_taille);
+
+    // chercher une position libre
+    if (!tirer_case_libre(jeu, &f->pos) || occuper_case(jeu, f->pos.x, f->pos.y, case_fruit_bonus) != 0) {
+        return -1;
+    }
+
+    // activer le fruit et rgler sa dure
+    f->actif = 1;
+    armer_minuteur(&jeu->minuteurs, minuteur_fruits + k, jeu->nb_pas + duree_fruit_bonus);
+    return k;
+}
+
+// fonction pour ajouter un segment au serpent
+// la queue reste en place au prochain dplacement au lieu d'avancer
+void ajouter_segment(jeu_snake* jeu) {
+    jeu->croissance++;
+}
+
+// fonction appele quand le serpent mange le fruit bonus k
+int consommer_fruit_bonus(jeu_snake* jeu, int k) {
+    int evenements = evenement_bonus;
+    fruit* f = &jeu->fruits[k];
+
+    // diffrents effets selon le type de fruit
+    switch (f->type) {
+        case fruit_normal:
+            // comme la nourriture normale
+            ajouter_segment(jeu);
+            jeu->score++;
+            break;
+
+        case fruit_bonus_score:
+            // ajoute 5 points supplmentaires
+            jeu->score += 5;
+            break;
+
+        case fruit_bonus_vitesse:
+            // acclre temporairement le serpent (un bonus dj en cours est prolong)
+            armer_minuteur(&jeu->minuteurs, minuteur_vitesse, jeu->nb_pas + duree_bonus_vitesse);
+            evenements |= evenement_vitesse_debut;  // le jeu passe  vitesse_rapide
+            break;
+
+        case fruit_bonus_taille:
+            // ajoute 3 segments d'un coup
+            for (int i = 0; i < 3; i++) {
+                ajouter_segment(jeu);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    // dsactiver le fruit bonus aprs consommation
+    f->actif = 0;
+    jeu->dernier_bonus = f->type;
+    arreter_minuteur(&jeu->minuteurs, minuteur_fruits + k);
+
+    return evenements;
+}
+
+// fonction pour grer l'tat des fruits bonus
+// seuls les minuteurs qui arrivent  chance  ce pas sont traits
+int mise_a_jour_fruits_bonus(jeu_snake* jeu) {
+    int evenements = 0;
+    PROFIL_DEBUT(profil_fruits);
+
+    int numero;
+    while ((numero = minuteur_echu(&jeu->minuteurs, jeu->nb_pas)) >= 0) {
+        if (numero == minuteur_apparition) {
+            // faire apparatre un fruit bonus et tirer le moment du suivant
+            if (placer_fruit_bonus(jeu) >= 0) {
+                evenements |= evenement_bonus_apparu;
+            }
+            armer_minuteur(&jeu->minuteurs, minuteur_apparition,
+                           jeu->nb_pas + valeur_aleatoire(&jeu->hasard, apparition_fruit_min, apparition_fruit_max));
+        } else if (numero == minuteur_vitesse) {
+            // fin du bonus: revenir  la vitesse normale
+            evenements |= evenement_vitesse_fin;
+        } else {
+            // le fruit n'a pas t mang  temps: librer sa case
+            fruit* f = &jeu->fruits[numero - minuteur_fruits];
+            f->actif = 0;
+            liberer_case(jeu, f->pos.x, f->pos.y);
+            evenements |= evenement_bonus_disparu;
+        }
+    }
+
+    PROFIL_FIN(profil_fruits);
+    return evenements;
+}
+
+// fonction pour connatre la vitesse du jeu (en pas par seconde)
+int vitesse_actuelle(const jeu_snake* jeu) {
+    return jeu->minuteurs.minuteurs[minuteur_vitesse].echeance >= 0 ? jeu->vitesse_rapide : jeu->vitesse_normale;
+}
+
+// fonction pour connatre le nombre de pas avant qu'un minuteur se dclenche
+int temps_restant(const jeu_snake* jeu, int numero) {
+    int echeance = jeu->minuteurs.minuteurs[numero].echeance;
+    return echeance >= 0 ? echeance - jeu->nb_pas : 0;
+}
+
+// fonction pour trouver le fruit bonus actif pos sur une case
+int fruit_sur_case(const jeu_snake* jeu, int x, int y) {
+    for (int k = 0; k < nb_fruits_max; k++) {
+        if (jeu->fruits[k].actif && jeu->fruits[k].pos.x == x && jeu->fruits[k].pos.y == y) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+// fonction principale pour dplacer le serpent: un pas de simulation
+// retourne les vnements survenus pendant ce pas
+int deplacer_serpent(jeu_snake* jeu) {
+    int evenements = 0;
+
+    // ne rien faire si le jeu est en pause ou termin
+    if (jeu->en_pause || jeu->game_over) return 0;
+
+    // tape 1: calculer la nouvelle position de la tte
+    position tete = *segment_serpent(jeu, 0);
+
+    // tape 2: dplacer la tte dans la direction choisie
+    switch (jeu->dir_actuelle) {
+        case dir_haut:    tete.y--; break;
+        case dir_bas:     tete.y++; break;
+        case dir_gauche:  tete.x--; break;
+        case dir_droite:  tete.x++; break;
+    }
+
+    // tape 3: vrifier collision avec les murs
+    if (tete.x < 0 || tete.x >= jeu->largeur ||
+        tete.y < 0 || tete.y >= jeu->hauteur) {
+        jeu->game_over = 1;
+        return evenement_mort_mur;  // sortir de la fonction si game over
+    }
+
+    // tape 4: vrifier collision avec un mur du niveau ou avec le serpent lui-mme
+    // (une seule lecture de la grille; le corps n'a pas encore boug: la queue compte comme un obstacle)
+    contenu_case contenu = lire_case(jeu, tete.x, tete.y);
+    if (contenu == case_mur) {
+        jeu->game_over = 1;
+        return evenement_mort_mur;
+    }
+    if (contenu == case_serpent) {
+        jeu->game_over = 1;
+        return evenement_mort_serpent;  // sortir de la fonction si game over
+    }
+
+    // le pas a lieu: les minuteurs de ce pas comptent  partir d'ici
+    jeu->nb_pas++;
+
+    // tape 5: dplacer le corps du serpent
+    /*il suffit d'crire la nouvelle tte dans le tampon et
+    d'avancer la queue, les autres segments ne bougent pas*/
+    // (plus de mmoire pour la nouvelle tte: la partie s'arrte, l'appelant dcide)
+    if ((jeu->longueur == jeu->capacite_corps && reserver_corps(jeu, jeu->longueur + 1) != 0) ||
+        occuper_case(jeu, tete.x, tete.y, case_serpent) != 0) {
+        jeu->game_over = 1;
+        return evenement_erreur;
+    }
+    jeu->indice_tete = (jeu->indice_tete + 1) & (jeu->capacite_corps - 1);
+    jeu->corps[jeu->indice_tete] = tete;
+
+    if (jeu->croissance > 0) {
+        // le serpent grandit: la queue reste en place
+        jeu->croissance--;
+        jeu->longueur++;
+    } else {
+        position* queue = &jeu->corps[jeu->indice_queue];
+        liberer_case(jeu, queue->x, queue->y);
+        jeu->indice_queue = (jeu->indice_queue + 1) & (jeu->capacite_corps - 1);
+    }
+
+    // tape 6: vrifier si la nourriture normale a t mange
+    if (tete.x == jeu->nourriture.x && tete.y == jeu->nourriture.y) {
+        ajouter_segment(jeu);    // grandir le serpent
+        jeu->score++;            // augmenter le score
+        evenements |= evenement_mange;
+        if (placer_nourriture(jeu) != 0) {  // placer une nouvelle nourriture
+            jeu->game_over = 1;
+            evenements |= evenement_erreur;
+        }
+    }
+
+    // tape 7: vrifier si un fruit bonus a t mang
+    int mange = fruit_sur_case(jeu, tete.x, tete.y);
+    if (mange >= 0) {
+        evenements |= consommer_fruit_bonus(jeu, mange);
+    }
+
+    // tape 8: mettre  jour l'tat des fruits bonus
+    evenements |= mise_a_jour_fruits_bonus(jeu);
+
+    return evenements;
+}
+
+// fonction pour librer un jeu et tout son plateau
+void detruire_jeu(jeu_snake* jeu) {
+    if (jeu == NULL) return;
+
+    liberer_blocs(jeu);
+    free(jeu->blocs);
+    free(jeu->arbre_libres);
+    free(jeu->corps);
+    free(jeu);
+}
+
+// fonction pour obtenir la k-ime case vide d'un bloc (numro dans le bloc)
+static int case_libre_bloc(const jeu_snake* jeu, int bloc, int k) {
+    if (jeu->blocs[bloc] != NULL) {
+        return jeu->blocs[bloc]->libres[k];
+    }
+    return (k / largeur_bloc(jeu, bloc)) * cote_bloc + k % largeur_bloc(jeu, bloc);
+}
+
+// fonction pour obtenir le nombre de cases vides d'un bloc
+static int nb_libres_bloc(const jeu_snake* jeu, int bloc) {
+    if (jeu->blocs[bloc] != NULL) {
+        return jeu->blocs[bloc]->nb_libres;
+    }
+    return largeur_bloc(jeu, bloc) * hauteur_bloc(jeu, bloc);
+}
+
+// fonction pour vrifier que deux jeux sont dans le mme tat
+// (mmes cases, mme ordre des cases vides, mme suite de hasard)
+// un bloc jamais allou quivaut  un bloc allou rest vide
+int jeux_identiques(const jeu_snake* a, const jeu_snake* b) {
+    if (a->largeur != b->largeur || a->hauteur != b->hauteur ||
+        a->longueur != b->longueur || a->croissance != b->croissance ||
+        a->nb_libres != b->nb_libres) {
+        return 0;
+    }
+
+    // segments du serpent, de la tte  la queue
+    for (int i = 0; i < a->longueur; i++) {
+        position pa = a->corps[(a->indice_tete - i) & (a->capacite_corps - 1)];
+        position pb = b->corps[(b->indice_tete - i) & (b->capacite_corps - 1)];
+        if (pa.x != pb.x || pa.y != pb.y) return 0;
+    }
+
+    // contenu des cases et listes des cases vides, bloc par bloc
+    for (int bloc = 0; bloc < a->largeur_blocs * a->hauteur_blocs; bloc++) {
+        if (a->blocs[bloc] == NULL && b->blocs[bloc] == NULL) continue;
+
+        int nb = nb_libres_bloc(a, bloc);
+        if (nb != nb_libres_bloc(b, bloc)) return 0;
+        for (int k = 0; k < nb; k++) {
+            if (case_libre_bloc(a, bloc, k) != case_libre_bloc(b, bloc, k)) return 0;
+        }
+
+        int x0 = (bloc % a->largeur_blocs) * cote_bloc;
+        int y0 = (bloc / a->largeur_blocs) * cote_bloc;
+        for (int y = y0; y < y0 + hauteur_bloc(a, bloc); y++) {
+            for (int x = x0; x < x0 + largeur_bloc(a, bloc); x++) {
+                if (lire_case(a, x, y) != lire_case(b, x, y)) return 0;
+            }
+        }
+    }
+
+    // rserve de fruits et minuteurs (la roue ne contient que des entiers)
+    for (int k = 0; k < nb_fruits_max; k++) {
+        const fruit* fa = &a->fruits[k];
+        const fruit* fb = &b->fruits[k];
+        if (fa->pos.x != fb->pos.x || fa->pos.y != fb->pos.y || fa->type != fb->type || fa->actif != fb->actif) {
+            return 0;
+        }
+    }
+    if (memcmp(&a->minuteurs, &b->minuteurs, sizeof(roue_minuteurs)) != 0) {
+        return 0;
+    }
+
+    return a->dir_actuelle == b->dir_actuelle &&
+           a->nourriture.x == b->nourriture.x && a->nourriture.y == b->nourriture.y &&
+           a->dernier_bonus == b->dernier_bonus &&
+           a->score == b->score && a->game_over == b->game_over &&
+           a->en_pause == b->en_pause && a->en_menu == b->en_menu &&
+           a->vitesse_normale == b->vitesse_normale && a->vitesse_rapide == b->vitesse_rapide &&
+           a->nb_pas == b->nb_pas &&
+           a->hasard.etat == b->hasard.etat && a->hasard.increment == b->hasard.increment;
+}
+
+// fonction pour connatre le nombre de pas entre deux cases d'un niveau (numros y * largeur + x)
+// une seule lecture dans la table calcule au chargement
+// retourne -1 si une des cases est un mur ou si le niveau n'a pas de table
+int distance_niveau(const niveau* niv, int depart, int arrivee) {
+    if (niv->distances == NULL || niv->rang_case[depart] < 0 || niv->rang_case[arrivee] < 0) {
+        return -1;
+    }
+    return niv->distances[(size_t)niv->rang_case[depart] * niv->nb_praticables + niv->rang_case[arrivee]];
+}
+
+// fonction pour lire une horloge monotone en secondes
+double horloge_secondes(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
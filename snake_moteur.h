@@ -0,0 +1,232 @@
+// moteur du jeu du serpent: rgles et tat d'une partie, sans fentre ni son
+// (utilisable sans raylib, par exemple pour simuler des parties en masse)
+#ifndef SNAKE_MOTEUR_H
+#define SNAKE_MOTEUR_H
+
+#include <stdint.h>
+
+// dimensions par dfaut du jeu (le plateau peut tre choisi au lancement avec creer_jeu;
+// le simulateur par lots utilise toujours ces dimensions)
+// (modifiables  la compilation, par exemple -Dlargeur_jeu=1000 -Dhauteur_jeu=1000)
+#ifndef largeur_jeu
+#define largeur_jeu 30             // nombre de carrs en largeur
+#endif
+#ifndef hauteur_jeu
+#define hauteur_jeu 20             // nombre de carrs en hauteur
+#endif
+#define nb_cases (largeur_jeu * hauteur_jeu)   // nombre total de cases (taille maximale du serpent)
+#define cote_bloc 64               // le plateau est dcoup en blocs de cote_bloc x cote_bloc cases
+#define cases_bloc (cote_bloc * cote_bloc)
+#define aucune_place 0xffff        // case absente de la liste des cases vides d'un bloc
+#define duree_fruit_bonus 50       // dure d'affichage d'un fruit bonus (5 secondes  10 fps)
+#define duree_bonus_vitesse 50     // dure du bonus de vitesse (5 secondes  10 fps)
+#define vitesse_normale_defaut 10  // pas de simulation par seconde
+#define vitesse_bonus 15           // pas par seconde pendant le bonus de vitesse
+// fruits bonus prsents en mme temps au plus, et pas entre deux apparitions
+// (modifiables  la compilation, par exemple -Dapparition_fruit_min=5 -Dapparition_fruit_max=10)
+#ifndef nb_fruits_max
+#define nb_fruits_max 4
+#endif
+#ifndef apparition_fruit_min
+#define apparition_fruit_min 80
+#endif
+#ifndef apparition_fruit_max
+#define apparition_fruit_max 120
+#endif
+#define taille_roue 64             // cases de la roue des minuteurs (puissance de 2)
+
+// types de fruits que le serpent peut manger
+typedef enum {
+    fruit_normal = 0,       // fruit normal (pomme)
+    fruit_bonus_score,      // bonus: +5 points
+    fruit_bonus_vitesse,    // bonus: acclre temporairement le serpent
+    fruit_bonus_taille      // bonus: ajoute 3 segments d'un coup
+} type_fruit;
+
+// directions possibles pour le serpent
+typedef enum {
+    dir_haut = 0,
+    dir_bas,
+    dir_gauche,
+    dir_droite
+} direction;
+
+// structure pour reprsenter une position sur la grille
+typedef struct {
+    int x;  // coordonne horizontale
+    int y;  // coordonne verticale
+} position;
+
+// contenu d'une case de la grille de jeu
+typedef enum {
+    case_vide = 0,          // case libre
+    case_serpent,           // occupe par un segment du serpent
+    case_nourriture,        // occupe par la nourriture normale
+    case_fruit_bonus,       // occupe par un fruit bonus
+    case_mur                // mur du niveau (pos au dbut de la partie, ne bouge plus)
+} contenu_case;
+
+// gnrateur pseudo-alatoire (pcg32) propre  chaque partie:
+// une mme graine donne toujours la mme partie
+typedef struct {
+    uint64_t etat;        // tat interne
+    uint64_t increment;   // squence choisie (toujours impair)
+} generateur;
+
+// vnements produits par un pas de simulation (combinables avec |)
+typedef enum {
+    evenement_mange          = 1 << 0,  // nourriture normale mange
+    evenement_bonus          = 1 << 1,  // fruit bonus mang (son type est dans dernier_bonus)
+    evenement_vitesse_debut  = 1 << 2,  // dbut du bonus de vitesse
+    evenement_vitesse_fin    = 1 << 3,  // fin du bonus de vitesse
+    evenement_bonus_apparu   = 1 << 4,  // un fruit bonus vient d'apparatre
+    evenement_bonus_disparu  = 1 << 5,  // un fruit bonus a expir sans tre mang
+    evenement_mort_mur       = 1 << 6,  // game over: collision avec un mur
+    evenement_mort_serpent   = 1 << 7,  // game over: collision avec le serpent
+    evenement_erreur         = 1 << 8   // game over: plus de mmoire pour le plateau ou le corps
+} evenement;
+
+// structure pour reprsenter un fruit spcial
+// (le temps avant qu'il disparaisse est tenu par son minuteur: temps_restant)
+typedef struct {
+    position pos;     // position du fruit
+    type_fruit type;  // type du fruit
+    int actif;       // est-il actuellement affich
+} fruit;
+
+// minuteurs d'une partie: apparition des fruits bonus, bonus de vitesse,
+// et disparition de chaque fruit de la rserve
+enum {
+    minuteur_apparition = 0,   // prochaine apparition d'un fruit bonus
+    minuteur_vitesse,          // fin du bonus de vitesse
+    minuteur_fruits,           // disparition du fruit k: minuteur_fruits + k
+    nb_minuteurs = minuteur_fruits + nb_fruits_max
+};
+
+typedef struct {
+    int32_t echeance;          // pas o le minuteur se dclenche (-1 s'il est arrt)
+    int16_t suivant;           // minuteurs rangs dans la mme case de la roue (-1 au bout)
+    int16_t precedent;
+} minuteur;
+
+// roue des minuteurs: un minuteur est rang dans la case echeance % taille_roue
+//  chaque pas, seule la case du pas est parcourue: le cot ne dpend que des
+// minuteurs qui s'y trouvent, pas du nombre de minuteurs arms
+// (ni pointeur ni allocation: la roue se copie avec le jeu)
+typedef struct {
+    int16_t cases[taille_roue];        // premier minuteur de chaque case (-1 si vide)
+    minuteur minuteurs[nb_minuteurs];
+} roue_minuteurs;
+
+// bloc de cote_bloc x cote_bloc cases du plateau
+// un bloc n'est allou que lorsqu'une de ses cases est occupe pour la premire fois:
+// tant qu'il n'existe pas, toutes ses cases sont vides, dans l'ordre des lignes
+typedef struct {
+    unsigned char cases[cases_bloc];   // contenu de chaque case (contenu_case)
+    uint16_t libres[cases_bloc];       // liste compacte des cases vides du bloc (numros dans le bloc)
+    uint16_t place[cases_bloc];        // place de chaque case dans libres (aucune_place si occupe)
+    int nb_libres;                     // nombre de cases vides du bloc
+} bloc_plateau;
+
+// niveau: murs intrieurs poss sur le plateau au dbut de chaque partie
+// (cr par charger_niveau dans snake_niveau.c; partag en lecture seule par les parties)
+// les distances sont celles du plateau vide de serpent: un minimum pour tout chemin rel
+typedef struct {
+    int largeur;
+    int hauteur;
+    unsigned char* murs;          // 1 pour chaque case mure (y * largeur + x), 0 sinon
+    int32_t* liste_murs;          // numros des cases mures, pour les poser vite
+    int nb_murs;
+    int32_t* rang_case;           // rang de chaque case praticable (-1 pour un mur)
+    int nb_praticables;
+    uint16_t* distances;          // nb_praticables x nb_praticables pas (NULL si le niveau est trop grand)
+} niveau;
+
+// structure principale du jeu qui contient tout l'tat du jeu
+typedef struct {
+    // dimensions du plateau, choisies  la cration
+    int largeur;                  // nombre de cases en largeur
+    int hauteur;                  // nombre de cases en hauteur
+    int largeur_blocs;            // nombre de blocs en largeur
+    int hauteur_blocs;            // nombre de blocs en hauteur
+    const niveau* niveau;         // murs poss par reinitialiser_jeu (NULL: plateau sans mur)
+    // corps du serpent stock dans un tampon circulaire:
+    // avancer = crire une case  la tte et librer celle de la queue
+    position* corps;              // positions des segments
+    int capacite_corps;           // taille du tampon (puissance de 2, double au besoin)
+    int indice_tete;              // indice de la tte dans le tampon
+    int indice_queue;             // indice du dernier segment dans le tampon
+    int longueur;                 // nombre de segments du serpent
+    int croissance;               // segments  ajouter lors des prochains dplacements
+    // grille d'occupation tenue  jour  chaque dplacement, dcoupe en blocs
+    // chaque bloc garde la liste de ses cases vides, pour tirer une case libre sans essais rpts
+    bloc_plateau** blocs;         // blocs de la grille (NULL tant qu'un bloc n'a jamais t occup)
+    bloc_plateau* zone_blocs;     // tous les blocs d'un coup, aprs reserver_jeu (sinon NULL)
+    int* arbre_libres;            // cases vides par bloc, cumules en arbre (arbre de Fenwick)
+    int nb_libres;                // nombre de cases vides
+    direction dir_actuelle;       // direction actuelle
+    position nourriture;          // position de la nourriture rgulire
+    fruit fruits[nb_fruits_max];  // rserve de fruits bonus (actif = emplacement pris)
+    type_fruit dernier_bonus;     // type du dernier fruit bonus mang
+    int score;                    // score du joueur
+    int game_over;               //  jeu termin
+    int en_pause;                // jeu en pause
+    int en_menu;                 //  dans le menu
+    roue_minuteurs minuteurs;     // apparition et disparition des fruits, bonus de vitesse
+    int vitesse_normale;          // vitesse normale du jeu en pas par seconde
+    int vitesse_rapide;           // vitesse pendant le bonus de vitesse
+    int nb_pas;                   // pas jous depuis le dbut de la partie
+    generateur hasard;            // gnrateur pseudo-alatoire de la partie
+} jeu_snake;
+
+
+// gnrateur pseudo-alatoire
+void initialiser_generateur(generateur* gen, uint64_t graine);
+int valeur_aleatoire(generateur* gen, int min, int max);  // bornes incluses
+
+// roue des minuteurs
+void vider_roue(roue_minuteurs* roue);
+void armer_minuteur(roue_minuteurs* roue, int numero, int echeance);   // le rarme s'il l'tait
+void arreter_minuteur(roue_minuteurs* roue, int numero);
+int minuteur_echu(roue_minuteurs* roue, int maintenant);   // retire un minuteur chu (-1 si aucun)
+
+// cration et tat de la partie
+jeu_snake* initialiser_jeu(uint64_t graine);   // plateau de largeur_jeu x hauteur_jeu
+jeu_snake* creer_jeu(int largeur, int hauteur, uint64_t graine);
+void reinitialiser_jeu(jeu_snake* jeu, uint64_t graine);   // nouvelle partie, sans allocation
+void detruire_jeu(jeu_snake* jeu);
+jeu_snake* allouer_jeu(int largeur, int hauteur);   // tat  remplir (copier_jeu...)
+int redimensionner_jeu(jeu_snake* jeu, int largeur, int hauteur);   // 0 si russi
+int reserver_jeu(jeu_snake* jeu);   // plus aucune allocation ensuite (0 si russi)
+long long allocations_moteur(void);   // allocations du moteur depuis le lancement
+int choisir_niveau(jeu_snake* jeu, const niveau* niv);   //  la prochaine partie (0 si russi)
+int copier_jeu(jeu_snake* destination, const jeu_snake* source);    // 0 si russi
+jeu_snake* cloner_jeu(const jeu_snake* source);
+position* segment_serpent(jeu_snake* jeu, int i);
+int reserver_corps(jeu_snake* jeu, int longueur);   // place pour longueur segments (0 si russi)
+bloc_plateau* bloc_alloue(jeu_snake* jeu, int bloc);   // alloue le bloc s'il n'existe pas encore (NULL si impossible)
+void vider_bloc(jeu_snake* jeu, int bloc);              // toutes ses cases redeviennent vides
+contenu_case lire_case(const jeu_snake* jeu, int x, int y);
+int occuper_case(jeu_snake* jeu, int x, int y, contenu_case contenu);   // 0 si russi
+void liberer_case(jeu_snake* jeu, int x, int y);
+void recalculer_libres(jeu_snake* jeu);         // aprs avoir modifi les blocs directement
+int est_sur_serpent(jeu_snake* jeu, int x, int y);
+int tirer_case_libre(jeu_snake* jeu, position* pos);
+int vitesse_actuelle(const jeu_snake* jeu);
+int temps_restant(const jeu_snake* jeu, int numero);   // pas avant le minuteur (0 s'il est arrt)
+int fruit_sur_case(const jeu_snake* jeu, int x, int y);   // fruit actif de la case (-1 si aucun)
+int jeux_identiques(const jeu_snake* a, const jeu_snake* b);  // mme tat de partie
+int distance_niveau(const niveau* niv, int depart, int arrivee);   // pas entre deux cases (-1 si inconnue)
+
+// rgles du jeu: chaque fonction retourne les vnements produits
+int placer_nourriture(jeu_snake* jeu);   // 0 si russi, 1 si la mmoire manque
+int placer_fruit_bonus(jeu_snake* jeu);   // fruit plac (-1 si la rserve ou le plateau est plein)
+void ajouter_segment(jeu_snake* jeu);
+int consommer_fruit_bonus(jeu_snake* jeu, int k);
+int mise_a_jour_fruits_bonus(jeu_snake* jeu);
+int deplacer_serpent(jeu_snake* jeu);  // un pas de simulation
+
+// horloge monotone en secondes (pour mesurer des dures)
+double horloge_secondes(void);
+
+#endif
@@ -0,0 +1,258 @@
+// niveaux lus dans des fichiers (voir snake_niveau.h)
+#include "snake_niveau.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const int dx[4] = { 0, 0, -1, 1 };  // dir_haut, dir_bas, dir_gauche, dir_droite
+static const int dy[4] = { -1, 1, 0, 0 };
+
+// fonction pour trouver la prochaine range de la carte  partir de *suivant
+// (les lignes vides et les commentaires sont sauts, le \r d'une fin de ligne \r\n retir)
+// retourne sa longueur, ou -1  la fin du texte
+static long long rangee_suivante(const char* texte, size_t taille, size_t* suivant, const char** rangee) {
+    while (*suivant < taille) {
+        size_t debut = *suivant;
+        size_t fin = debut;
+        while (fin < taille && texte[fin] != '\n') fin++;
+        *suivant = fin + 1;
+        if (fin > debut && texte[fin - 1] == '\r') fin--;
+        if (fin == debut || texte[debut] == ';') continue;
+
+        *rangee = texte + debut;
+        return (long long)(fin - debut);
+    }
+    return -1;
+}
+
+// fonction pour parcourir en largeur les cases praticables d'un niveau depuis une case
+// distance[case] reoit le nombre de pas depuis le dpart (-1 si la case n'est pas atteinte)
+static void parcourir_niveau(const niveau* niv, int depart, int32_t* distance, int32_t* file) {
+    int nb = niv->largeur * niv->hauteur;
+    for (int c = 0; c < nb; c++) distance[c] = -1;
+
+    int debut = 0;
+    int fin = 0;
+    distance[depart] = 0;
+    file[fin++] = depart;
+    while (debut < fin) {
+        int c = file[debut++];
+        int x = c % niv->largeur;
+        int y = c / niv->largeur;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dx[d];
+            int ny = y + dy[d];
+            if (nx < 0 || nx >= niv->largeur || ny < 0 || ny >= niv->hauteur) continue;
+            int voisine = ny * niv->largeur + nx;
+            if (niv->murs[voisine] || distance[voisine] >= 0) continue;
+            distance[voisine] = distance[c] + 1;
+            file[fin++] = voisine;
+        }
+    }
+}
+
+// fonction pour murer les cases inaccessibles et ranger les cases du niveau
+// (liste des murs, rang de chaque case praticable)
+// retourne 0 si tout s'est bien pass
+static int ranger_cases(niveau* niv, const int32_t* distance) {
+    int nb = niv->largeur * niv->hauteur;
+    niv->nb_murs = 0;
+    niv->nb_praticables = 0;
+    for (int c = 0; c < nb; c++) {
+        if (distance[c] < 0) niv->murs[c] = 1;
+        if (niv->murs[c]) niv->nb_murs++;
+    }
+
+    niv->liste_murs = (int32_t*)malloc((niv->nb_murs > 0 ? niv->nb_murs : 1) * sizeof(int32_t));
+    niv->rang_case = (int32_t*)malloc(nb * sizeof(int32_t));
+    if (niv->liste_murs == NULL || niv->rang_case == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le niveau\n");
+        return 1;
+    }
+
+    int k = 0;
+    for (int c = 0; c < nb; c++) {
+        if (niv->murs[c]) {
+            niv->liste_murs[k++] = c;
+            niv->rang_case[c] = -1;
+        } else {
+            niv->rang_case[c] = niv->nb_praticables++;
+        }
+    }
+    return 0;
+}
+
+// fonction pour calculer la table des distances entre toutes les cases praticables
+// (un parcours en largeur depuis chaque case; ligne r: distances depuis la case de rang r)
+// retourne 0 si tout s'est bien pass
+static int calculer_distances(niveau* niv, int32_t* distance, int32_t* file) {
+    size_t n = (size_t)niv->nb_praticables;
+    niv->distances = (uint16_t*)malloc(n * n * sizeof(uint16_t));
+    if (niv->distances == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour les distances du niveau\n");
+        return 1;
+    }
+
+    int nb = niv->largeur * niv->hauteur;
+    for (int depart = 0; depart < nb; depart++) {
+        if (niv->murs[depart]) continue;
+        parcourir_niveau(niv, depart, distance, file);
+
+        // toutes les cases praticables sont atteintes: les autres ont t mures
+        uint16_t* ligne = niv->distances + (size_t)niv->rang_case[depart] * n;
+        for (int c = 0; c < nb; c++) {
+            if (!niv->murs[c]) ligne[niv->rang_case[c]] = (uint16_t)distance[c];
+        }
+    }
+    return 0;
+}
+
+// fonction pour crer un niveau  partir du texte d'une carte
+niveau* lire_niveau(const char* texte, size_t taille) {
+    // premire lecture: dimensions et caractres
+    long long largeur = 0;
+    long long hauteur = 0;
+    size_t suivant = 0;
+    const char* rangee;
+    long long longueur;
+    while ((longueur = rangee_suivante(texte, taille, &suivant, &rangee)) >= 0) {
+        if (hauteur > 0 && longueur != largeur) {
+            printf("erreur: niveau invalide: la range %lld a %lld cases au lieu de %lld\n",
+                   hauteur + 1, longueur, largeur);
+            return NULL;
+        }
+        for (long long x = 0; x < longueur; x++) {
+            if (rangee[x] != '#' && rangee[x] != '.') {
+                printf("erreur: niveau invalide: caractre inconnu '%c' dans la range %lld\n", rangee[x], hauteur + 1);
+                return NULL;
+            }
+        }
+        largeur = longueur;
+        hauteur++;
+    }
+    if (largeur < 5 || hauteur < 1 || largeur * hauteur > 1000000000) {
+        printf("erreur: niveau invalide: taille de plateau impossible: %lld x %lld\n", largeur, hauteur);
+        return NULL;
+    }
+
+    niveau* niv = (niveau*)calloc(1, sizeof(niveau));
+    if (niv == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le niveau\n");
+        return NULL;
+    }
+    niv->largeur = (int)largeur;
+    niv->hauteur = (int)hauteur;
+    int nb = niv->largeur * niv->hauteur;
+    niv->murs = (unsigned char*)malloc(nb);
+    int32_t* distance = (int32_t*)malloc(nb * sizeof(int32_t));
+    int32_t* file = (int32_t*)malloc(nb * sizeof(int32_t));
+    if (niv->murs == NULL || distance == NULL || file == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le niveau\n");
+        free(distance);
+        free(file);
+        detruire_niveau(niv);
+        return NULL;
+    }
+
+    // deuxime lecture: les murs
+    suivant = 0;
+    for (int y = 0; y < niv->hauteur; y++) {
+        rangee_suivante(texte, taille, &suivant, &rangee);
+        for (int x = 0; x < niv->largeur; x++) {
+            niv->murs[y * niv->largeur + x] = rangee[x] == '#';
+        }
+    }
+
+    // le serpent part du milieu vers la droite (comme reinitialiser_jeu):
+    // ses trois cases et celle devant sa tte doivent tre libres
+    int tete = (niv->hauteur / 2) * niv->largeur + niv->largeur / 2;
+    int erreur = niv->murs[tete - 2] || niv->murs[tete - 1] || niv->murs[tete] || niv->murs[tete + 1];
+    if (erreur) {
+        printf("erreur: niveau invalide: le dpart du serpent (%d, %d) est mur\n", niv->largeur / 2, niv->hauteur / 2);
+    }
+
+    // cases accessibles depuis la tte de dpart; les autres sont mures
+    if (!erreur) {
+        parcourir_niveau(niv, tete, distance, file);
+        erreur = ranger_cases(niv, distance);
+    }
+    if (!erreur && niv->nb_praticables < 4) {
+        printf("erreur: niveau invalide: aucune case libre pour la nourriture\n");
+        erreur = 1;
+    }
+    if (!erreur && niv->nb_praticables <= cases_distances_max) {
+        erreur = calculer_distances(niv, distance, file);
+    }
+
+    free(distance);
+    free(file);
+    if (erreur) {
+        detruire_niveau(niv);
+        return NULL;
+    }
+    return niv;
+}
+
+// fonction pour charger un niveau depuis un fichier
+// le fichier est projet en mmoire et lu directement depuis la projection
+niveau* charger_niveau(const char* chemin) {
+#ifdef _WIN32
+    // pas de mmap: le fichier est lu d'un seul bloc
+    FILE* fichier = fopen(chemin, "rb");
+    if (fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return NULL;
+    }
+    fseek(fichier, 0, SEEK_END);
+    long taille = ftell(fichier);
+    fseek(fichier, 0, SEEK_SET);
+    char* texte = taille > 0 ? (char*)malloc(taille) : NULL;
+    niveau* niv = NULL;
+    if (texte != NULL && fread(texte, 1, taille, fichier) == (size_t)taille) {
+        niv = lire_niveau(texte, taille);
+    } else {
+        printf("erreur: impossible de lire %s\n", chemin);
+    }
+    free(texte);
+    fclose(fichier);
+    return niv;
+#else
+    int descripteur = open(chemin, O_RDONLY);
+    if (descripteur < 0) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return NULL;
+    }
+    struct stat infos;
+    if (fstat(descripteur, &infos) != 0 || infos.st_size == 0) {
+        printf("erreur: %s est vide\n", chemin);
+        close(descripteur);
+        return NULL;
+    }
+    void* texte = mmap(NULL, infos.st_size, PROT_READ, MAP_PRIVATE, descripteur, 0);
+    close(descripteur);
+    if (texte == MAP_FAILED) {
+        printf("erreur: impossible de projeter %s en mmoire\n", chemin);
+        return NULL;
+    }
+    niveau* niv = lire_niveau((const char*)texte, infos.st_size);
+    munmap(texte, infos.st_size);
+    return niv;
+#endif
+}
+
+// fonction pour librer un niveau (les jeux qui l'utilisent ne doivent plus recommencer de partie)
+void detruire_niveau(niveau* niv) {
+    if (niv == NULL) return;
+
+    free(niv->murs);
+    free(niv->liste_murs);
+    free(niv->rang_case);
+    free(niv->distances);
+    free(niv);
+}
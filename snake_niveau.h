@@ -0,0 +1,31 @@
+// niveaux: murs intrieurs lus dans un fichier texte
+// une ligne par range du plateau, toutes de mme longueur: '#' pour un mur, '.' pour une case libre
+// (les lignes vides et celles qui commencent par ';' sont ignores, les fins de ligne \r\n acceptes)
+//
+// le fichier est projet en mmoire et vrifi au chargement:
+// - les cases de dpart du serpent et celle devant sa tte doivent tre libres
+// - les cases que le serpent ne peut pas atteindre depuis son dpart sont mures,
+//   pour que la nourriture et les fruits ne tombent jamais dans une poche ferme
+// - les distances entre toutes les cases praticables sont calcules une fois pour toutes
+//   (un parcours en largeur par case), pour rpondre en une lecture pendant la partie
+#ifndef SNAKE_NIVEAU_H
+#define SNAKE_NIVEAU_H
+
+#include "snake_moteur.h"
+#include <stddef.h>
+
+// au-del de ce nombre de cases praticables, la table des distances n'est pas calcule
+// (elle prend 2 octets par paire de cases: 32 Mo pour 4096 cases)
+#ifndef cases_distances_max
+#define cases_distances_max 4096
+#endif
+
+// cre un niveau  partir du texte d'une carte; retourne NULL si la carte est invalide
+niveau* lire_niveau(const char* texte, size_t taille);
+
+// charge un niveau depuis un fichier (projet en mmoire); retourne NULL en cas d'erreur
+niveau* charger_niveau(const char* chemin);
+
+void detruire_niveau(niveau* niv);
+
+#endif
@@ -0,0 +1,131 @@
+// paquet de ressources (voir snake_paquet.h)
+#include "snake_paquet.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// fonction pour vrifier que l'en-tte et toutes les entres tiennent dans le paquet
+static int paquet_valide(const unsigned char* octets, size_t taille) {
+    const entete_paquet* entete = (const entete_paquet*)octets;
+    if (taille < sizeof(entete_paquet) || entete->magie != magie_paquet ||
+        entete->nb_entrees > (taille - sizeof(entete_paquet)) / sizeof(entree_paquet)) {
+        return 0;
+    }
+
+    const entree_paquet* entrees = (const entree_paquet*)(octets + sizeof(entete_paquet));
+    for (uint32_t i = 0; i < entete->nb_entrees; i++) {
+        if (memchr(entrees[i].nom, 0, taille_nom_paquet) == NULL ||
+            entrees[i].decalage > taille || entrees[i].taille > taille - entrees[i].decalage) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// fonction pour crer le paquet une fois les octets en mmoire
+static paquet* nouveau_paquet(const unsigned char* octets, size_t taille, int origine) {
+    if (!paquet_valide(octets, taille)) {
+        printf("erreur: paquet de ressources invalide\n");
+        return NULL;
+    }
+
+    paquet* paq = (paquet*)malloc(sizeof(paquet));
+    if (paq == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le paquet\n");
+        return NULL;
+    }
+    paq->octets = octets;
+    paq->taille = taille;
+    paq->origine = origine;
+    return paq;
+}
+
+// fonction pour utiliser un paquet dj en mmoire
+paquet* ouvrir_paquet_memoire(const void* octets, size_t taille) {
+    return nouveau_paquet((const unsigned char*)octets, taille, origine_integre);
+}
+
+// fonction pour ouvrir un fichier paquet
+paquet* ouvrir_paquet(const char* chemin) {
+#ifdef _WIN32
+    // pas de mmap: le fichier est lu d'un seul bloc
+    FILE* fichier = fopen(chemin, "rb");
+    if (fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return NULL;
+    }
+    fseek(fichier, 0, SEEK_END);
+    long taille = ftell(fichier);
+    fseek(fichier, 0, SEEK_SET);
+    unsigned char* octets = taille > 0 ? (unsigned char*)malloc(taille) : NULL;
+    if (octets == NULL || fread(octets, 1, taille, fichier) != (size_t)taille) {
+        printf("erreur: impossible de lire %s\n", chemin);
+        free(octets);
+        fclose(fichier);
+        return NULL;
+    }
+    fclose(fichier);
+
+    paquet* paq = nouveau_paquet(octets, taille, origine_lue);
+    if (paq == NULL) free(octets);
+    return paq;
+#else
+    int descripteur = open(chemin, O_RDONLY);
+    if (descripteur < 0) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return NULL;
+    }
+    struct stat infos;
+    if (fstat(descripteur, &infos) != 0 || infos.st_size == 0) {
+        printf("erreur: %s est vide\n", chemin);
+        close(descripteur);
+        return NULL;
+    }
+    void* octets = mmap(NULL, infos.st_size, PROT_READ, MAP_PRIVATE, descripteur, 0);
+    close(descripteur);
+    if (octets == MAP_FAILED) {
+        printf("erreur: impossible de projeter %s en mmoire\n", chemin);
+        return NULL;
+    }
+
+    paquet* paq = nouveau_paquet((const unsigned char*)octets, infos.st_size, origine_projete);
+    if (paq == NULL) munmap(octets, infos.st_size);
+    return paq;
+#endif
+}
+
+// fonction pour fermer un paquet
+void fermer_paquet(paquet* paq) {
+    if (paq == NULL) return;
+
+#ifndef _WIN32
+    if (paq->origine == origine_projete) {
+        munmap((void*)paq->octets, paq->taille);
+    }
+#endif
+    if (paq->origine == origine_lue) {
+        free((void*)paq->octets);
+    }
+    free(paq);
+}
+
+// fonction pour trouver une ressource par son nom
+const unsigned char* chercher_ressource(const paquet* paq, const char* nom, size_t* taille) {
+    if (paq == NULL) return NULL;
+
+    const entete_paquet* entete = (const entete_paquet*)paq->octets;
+    const entree_paquet* entrees = (const entree_paquet*)(paq->octets + sizeof(entete_paquet));
+    for (uint32_t i = 0; i < entete->nb_entrees; i++) {
+        if (strcmp(entrees[i].nom, nom) == 0) {
+            *taille = entrees[i].taille;
+            return paq->octets + entrees[i].decalage;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,49 @@
+// paquet de ressources: toutes les images et tous les sons du jeu dans un seul fichier
+// le fichier est projet en mmoire (ou intgr au programme) et les ressources
+// sont lues directement dedans, sans copie
+//
+// format: entete_paquet, puis nb_entrees entree_paquet, puis les donnes
+// (chaque ressource commence sur un multiple de alignement_paquet octets)
+#ifndef SNAKE_PAQUET_H
+#define SNAKE_PAQUET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define magie_paquet 0x4b504e53u   // "SNPK"
+#define taille_nom_paquet 56       // nom de la ressource, termin par un zro
+#define alignement_paquet 16
+
+typedef struct {
+    uint32_t magie;
+    uint32_t nb_entrees;
+} entete_paquet;
+
+// une ressource du paquet
+typedef struct {
+    char nom[taille_nom_paquet];   // nom du fichier, par exemple "manger.wav"
+    uint32_t decalage;             // dbut des donnes depuis le dbut du paquet
+    uint32_t taille;
+} entree_paquet;
+
+// paquet ouvert
+typedef struct {
+    const unsigned char* octets;
+    size_t taille;
+    int origine;                   // origine_integre, origine_projete ou origine_lue
+} paquet;
+
+enum { origine_integre = 0, origine_projete, origine_lue };
+
+// ouvre un fichier paquet; retourne NULL s'il est absent ou invalide
+paquet* ouvrir_paquet(const char* chemin);
+
+// utilise un paquet dj en mmoire (par exemple intgr au programme)
+paquet* ouvrir_paquet_memoire(const void* octets, size_t taille);
+
+void fermer_paquet(paquet* paq);
+
+// donnes d'une ressource (dans le paquet); retourne NULL si elle n'y est pas
+const unsigned char* chercher_ressource(const paquet* paq, const char* nom, size_t* taille);
+
+#endif
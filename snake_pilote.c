@@ -0,0 +1,378 @@
+// pilote automatique (voir snake_pilote.h)
+#include "snake_pilote.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+static const int dx[4] = { 0, 0, -1, 1 };  // dir_haut, dir_bas, dir_gauche, dir_droite
+static const int dy[4] = { -1, 1, 0, 0 };
+
+// fonction pour obtenir le numro de la case du i-me segment (0 = la tte)
+static int case_segment(const pilote* p, const jeu_snake* jeu, int i) {
+    const position* segment = &jeu->corps[(jeu->indice_tete - i) & (jeu->capacite_corps - 1)];
+    return segment->y * p->largeur + segment->x;
+}
+
+// fonction pour prparer le circuit: ligne 0 vers la droite, lignes suivantes en zigzag
+// sans la colonne 0, retour par la colonne 0 (comme dans bench_main.c)
+// si la hauteur est impaire, le circuit est trac en changeant lignes et colonnes
+static void preparer_cycle(pilote* p) {
+    int echange = p->hauteur % 2 != 0;
+    int l = echange ? p->hauteur : p->largeur;
+    int h = echange ? p->largeur : p->hauteur;
+    int* ordre = p->file;  // sert de tableau temporaire
+    int k = 0;
+
+    for (int u = 0; u < l; u++) {
+        ordre[k++] = echange ? u * p->largeur : u;
+    }
+    for (int v = 1; v < h; v++) {
+        for (int i = 1; i < l; i++) {
+            int u = v % 2 == 1 ? l - i : i;
+            ordre[k++] = echange ? u * p->largeur + v : v * p->largeur + u;
+        }
+    }
+    for (int v = h - 1; v >= 1; v--) {
+        ordre[k++] = echange ? v : v * p->largeur;
+    }
+
+    for (int i = 0; i < k; i++) {
+        p->cycle_suivant[ordre[i]] = ordre[(i + 1) % k];
+    }
+}
+
+// fonction pour crer un pilote pour un plateau
+pilote* creer_pilote(int largeur, int hauteur) {
+    int n = largeur * hauteur;
+    pilote* p = (pilote*)calloc(1, sizeof(pilote));
+    if (p == NULL) {
+        printf("erreur: impossible d'allouer le pilote\n");
+        return NULL;
+    }
+    p->largeur = largeur;
+    p->hauteur = hauteur;
+    p->liberation = (int*)malloc(n * sizeof(int));
+    p->etat_case = (uint32_t*)calloc(n, sizeof(uint32_t));
+    p->vu = (uint32_t*)calloc(n, sizeof(uint32_t));
+    p->precedent = (int*)malloc(n * sizeof(int));
+    p->distance = (int*)malloc(n * sizeof(int));
+    p->file = (int*)malloc(n * sizeof(int));
+    p->chemin = (int*)malloc(n * sizeof(int));
+    p->tete_attendue = -1;
+
+    // le circuit n'existe que si une des deux dimensions est paire
+    int circuit = largeur >= 2 && hauteur >= 2 && (largeur % 2 == 0 || hauteur % 2 == 0);
+    if (circuit) {
+        p->cycle_suivant = (int*)malloc(n * sizeof(int));
+    }
+
+    if (p->liberation == NULL || p->etat_case == NULL || p->vu == NULL || p->precedent == NULL ||
+        p->distance == NULL || p->file == NULL || p->chemin == NULL || (circuit && p->cycle_suivant == NULL)) {
+        printf("erreur: impossible d'allouer le pilote\n");
+        detruire_pilote(p);
+        return NULL;
+    }
+    if (circuit) {
+        preparer_cycle(p);
+    }
+    return p;
+}
+
+// fonction pour librer un pilote
+void detruire_pilote(pilote* p) {
+    if (p == NULL) return;
+    free(p->liberation);
+    free(p->etat_case);
+    free(p->vu);
+    free(p->precedent);
+    free(p->distance);
+    free(p->file);
+    free(p->chemin);
+    free(p->cycle_suivant);
+    free(p);
+}
+
+// fonction pour commencer un nouvel tat du serpent (toutes les cases redeviennent libres)
+static void nouvel_etat(pilote* p) {
+    if (++p->numero_etat == 0) {
+        memset(p->etat_case, 0, (size_t)p->largeur * p->hauteur * sizeof(uint32_t));
+        p->numero_etat = 1;
+    }
+}
+
+// fonction pour noter qu'une case n'est libre qu' partir d'un pas donn
+static void marquer(pilote* p, int c, int pas) {
+    p->etat_case[c] = p->numero_etat;
+    p->liberation[c] = pas;
+}
+
+// fonction pour savoir si le serpent peut entrer dans une case  un pas donn
+static int praticable(const pilote* p, int c, int pas) {
+    if (p->niveau != NULL && p->niveau->murs[c]) return 0;
+    return p->etat_case[c] != p->numero_etat || pas >= p->liberation[c];
+}
+
+// fonction pour noter l'tat actuel du serpent
+// le segment i (0 = la tte) est encore l pendant les longueur - i + croissance prochains pas;
+// la collision est vrifie avant que la queue avance
+static void etat_courant(pilote* p, const jeu_snake* jeu) {
+    nouvel_etat(p);
+    for (int i = 0; i < jeu->longueur; i++) {
+        marquer(p, case_segment(p, jeu, i), jeu->longueur - i + 1 + jeu->croissance);
+    }
+}
+
+// fonction pour noter l'tat du serpent aprs avoir suivi chemin[0..n-1]
+// retourne la case de la queue
+static int etat_apres(pilote* p, const jeu_snake* jeu, const int* chemin, int n) {
+    int nourriture = jeu->nourriture.x >= 0 ? jeu->nourriture.y * p->largeur + jeu->nourriture.x : -1;
+    int fruits[nb_fruits_max];     // case de chaque fruit bonus qui fait grandir (-1 sinon)
+    int gains[nb_fruits_max];
+    for (int k = 0; k < nb_fruits_max; k++) {
+        const fruit* f = &jeu->fruits[k];
+        gains[k] = f->type == fruit_bonus_taille ? 3 : f->type == fruit_normal ? 1 : 0;
+        fruits[k] = f->actif && gains[k] > 0 ? f->pos.y * p->largeur + f->pos.x : -1;
+    }
+
+    // rejouer la croissance le long du chemin
+    int longueur = jeu->longueur;
+    int croissance = jeu->croissance;
+    for (int j = 0; j < n; j++) {
+        if (croissance > 0) {
+            croissance--;
+            longueur++;
+        }
+        if (chemin[j] == nourriture) croissance++;
+        for (int k = 0; k < nb_fruits_max; k++) {
+            if (chemin[j] == fruits[k]) croissance += gains[k];
+        }
+    }
+
+    // nouveau corps: les cases du chemin (la dernire est la tte), puis l'ancien corps
+    nouvel_etat(p);
+    for (int i = 0; n + i < longueur && i < jeu->longueur; i++) {
+        marquer(p, case_segment(p, jeu, i), longueur - (n + i) + 1 + croissance);
+    }
+    for (int j = 0; j < n; j++) {
+        int indice = n - 1 - j;
+        if (indice < longueur) {
+            marquer(p, chemin[j], longueur - indice + 1 + croissance);
+        }
+    }
+    return longueur - 1 >= n ? case_segment(p, jeu, longueur - 1 - n) : chemin[n - longueur];
+}
+
+// fonction pour parcourir en largeur depuis une case: une case n'est prise que si
+// elle est praticable au pas o le serpent y arrive
+// s'arrte ds que les cibles a et b (-1 si absentes) sont vues; retourne le nombre de cases vues
+static int parcourir(pilote* p, int depart, int cible_a, int cible_b) {
+    if (++p->numero_recherche == 0) {
+        memset(p->vu, 0, (size_t)p->largeur * p->hauteur * sizeof(uint32_t));
+        p->numero_recherche = 1;
+    }
+    uint32_t numero = p->numero_recherche;
+    int restantes = (cible_a >= 0) + (cible_b >= 0);
+    int debut = 0;
+    int fin = 0;
+
+    p->vu[depart] = numero;
+    p->distance[depart] = 0;
+    p->precedent[depart] = -1;
+    p->file[fin++] = depart;
+
+    while (debut < fin) {
+        int c = p->file[debut++];
+        int x = c % p->largeur;
+        int y = c / p->largeur;
+        int pas = p->distance[c] + 1;
+
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dx[d];
+            int ny = y + dy[d];
+            if (nx < 0 || nx >= p->largeur || ny < 0 || ny >= p->hauteur) continue;
+            int voisine = ny * p->largeur + nx;
+            if (p->vu[voisine] == numero || !praticable(p, voisine, pas)) continue;
+
+            p->vu[voisine] = numero;
+            p->distance[voisine] = pas;
+            p->precedent[voisine] = c;
+            p->file[fin++] = voisine;
+            if ((voisine == cible_a || voisine == cible_b) && --restantes == 0) {
+                return fin;
+            }
+        }
+    }
+    return fin;
+}
+
+// fonction pour savoir si la queue reste atteignable aprs avoir suivi chemin[0..n-1]
+// retourne la distance de la nouvelle tte  la queue, ou -1
+static int queue_atteignable(pilote* p, const jeu_snake* jeu, const int* chemin, int n) {
+    int queue = etat_apres(p, jeu, chemin, n);
+    int tete = chemin[n - 1];
+    if (queue == tete) return 0;  // serpent d'une case
+
+    parcourir(p, tete, queue, -1);
+    return p->vu[queue] == p->numero_recherche ? p->distance[queue] : -1;
+}
+
+// fonction pour obtenir la direction qui mne d'une case  sa voisine
+static direction direction_vers(const pilote* p, int depuis, int vers) {
+    if (vers == depuis + 1) return dir_droite;
+    if (vers == depuis - 1) return dir_gauche;
+    if (vers == depuis + p->largeur) return dir_bas;
+    return dir_haut;
+}
+
+// fonction pour noter la partie telle qu'elle doit rester pour que le chemin soit valable
+static void memoriser_partie(pilote* p, const jeu_snake* jeu) {
+    p->taille_attendue = jeu->longueur + jeu->croissance;
+    p->nourriture_attendue = jeu->nourriture;
+    memcpy(p->fruits_attendus, jeu->fruits, sizeof(p->fruits_attendus));
+}
+
+// fonction pour savoir si la partie a volu comme prvu depuis le calcul du chemin
+static int partie_attendue(const pilote* p, const jeu_snake* jeu, int tete) {
+    if (p->etape >= p->longueur_chemin || tete != p->tete_attendue ||
+        jeu->longueur + jeu->croissance != p->taille_attendue ||
+        jeu->nourriture.x != p->nourriture_attendue.x || jeu->nourriture.y != p->nourriture_attendue.y) {
+        return 0;
+    }
+    for (int k = 0; k < nb_fruits_max; k++) {
+        const fruit* f = &jeu->fruits[k];
+        const fruit* attendu = &p->fruits_attendus[k];
+        if (f->actif != attendu->actif ||
+            (f->actif && (f->pos.x != attendu->pos.x || f->pos.y != attendu->pos.y))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// fonction pour chercher un chemin sr vers un fruit (les fruits bonus d'abord)
+// retourne 1 si un chemin a t trouv et rang dans p->chemin
+static int planifier(pilote* p, const jeu_snake* jeu, int tete) {
+    int cibles[nb_fruits_max + 1];
+    int delais[nb_fruits_max + 1];   // pas avant que la cible disparaisse
+    int nb_cibles = 0;
+    for (int k = 0; k < nb_fruits_max; k++) {
+        const fruit* f = &jeu->fruits[k];
+        if (f->actif) {
+            delais[nb_cibles] = temps_restant(jeu, minuteur_fruits + k);
+            cibles[nb_cibles++] = f->pos.y * p->largeur + f->pos.x;
+        }
+    }
+    if (jeu->nourriture.x >= 0) {
+        delais[nb_cibles] = p->largeur * p->hauteur;
+        cibles[nb_cibles++] = jeu->nourriture.y * p->largeur + jeu->nourriture.x;
+    }
+
+    for (int k = 0; k < nb_cibles; k++) {
+        int cible = cibles[k];
+
+        // sur un niveau, la distance sans serpent se lit dans la table: un fruit qui
+        // disparatra avant mme ce chemin le plus court ne vaut pas une recherche
+        if (p->niveau != NULL && distance_niveau(p->niveau, tete, cible) > delais[k]) continue;
+
+        etat_courant(p, jeu);
+        parcourir(p, tete, cible, -1);
+        if (p->vu[cible] != p->numero_recherche) continue;
+        // le fruit bonus doit encore tre l  l'arrive
+        if (p->distance[cible] > delais[k]) continue;
+
+        int n = p->distance[cible];
+        for (int c = cible, j = n - 1; j >= 0; c = p->precedent[c], j--) {
+            p->chemin[j] = c;
+        }
+        if (queue_atteignable(p, jeu, p->chemin, n) >= 0) {
+            p->longueur_chemin = n;
+            p->etape = 0;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// fonction pour choisir un pas sans chemin sr vers un fruit:
+// suivre le circuit si la queue reste atteignable, sinon aller vers la case
+// d'o la queue est la plus loin, sinon vers la plus grande zone libre
+static direction direction_secours(pilote* p, const jeu_snake* jeu, int tete) {
+    int voisines[4];
+    int x = tete % p->largeur;
+    int y = tete / p->largeur;
+
+    etat_courant(p, jeu);
+    for (int d = 0; d < 4; d++) {
+        int nx = x + dx[d];
+        int ny = y + dy[d];
+        int voisine = ny * p->largeur + nx;
+        int dedans = nx >= 0 && nx < p->largeur && ny >= 0 && ny < p->hauteur;
+        voisines[d] = dedans && praticable(p, voisine, 1) ? voisine : -1;
+    }
+
+    if (p->cycle_suivant != NULL && p->niveau == NULL) {
+        int suivante = p->cycle_suivant[tete];
+        for (int d = 0; d < 4; d++) {
+            if (voisines[d] == suivante && queue_atteignable(p, jeu, &voisines[d], 1) >= 0) {
+                return (direction)d;
+            }
+        }
+    }
+
+    int meilleure = -1;
+    int meilleure_distance = -1;
+    for (int d = 0; d < 4; d++) {
+        if (voisines[d] < 0) continue;
+        int distance = queue_atteignable(p, jeu, &voisines[d], 1);
+        if (distance > meilleure_distance) {
+            meilleure_distance = distance;
+            meilleure = d;
+        }
+    }
+    if (meilleure >= 0) {
+        return (direction)meilleure;
+    }
+
+    // aucune case sre: garder le plus de place possible
+    p->impasses++;
+    int meilleure_zone = -1;
+    for (int d = 0; d < 4; d++) {
+        if (voisines[d] < 0) continue;
+        etat_apres(p, jeu, &voisines[d], 1);
+        int zone = parcourir(p, voisines[d], -1, -1);
+        if (zone > meilleure_zone) {
+            meilleure_zone = zone;
+            meilleure = d;
+        }
+    }
+    return meilleure >= 0 ? (direction)meilleure : jeu->dir_actuelle;
+}
+
+// fonction pour choisir la direction du prochain pas
+direction choisir_direction(pilote* p, const jeu_snake* jeu) {
+    const position* segment = &jeu->corps[jeu->indice_tete];
+    int tete = segment->y * p->largeur + segment->x;
+    p->decisions++;
+
+    // le niveau ne sert que s'il a la taille du plateau du pilote
+    p->niveau = jeu->niveau != NULL && jeu->niveau->largeur == p->largeur &&
+                jeu->niveau->hauteur == p->hauteur ? jeu->niveau : NULL;
+
+    // suivre le chemin dj calcul si rien d'imprvu n'est arriv
+    if (partie_attendue(p, jeu, tete)) {
+        p->reutilisations++;
+    } else if (planifier(p, jeu, tete)) {
+        p->plans++;
+        memoriser_partie(p, jeu);
+    } else {
+        p->secours++;
+        p->longueur_chemin = 0;
+        p->etape = 0;
+        p->tete_attendue = -1;
+        return direction_secours(p, jeu, tete);
+    }
+
+    int suivante = p->chemin[p->etape++];
+    p->tete_attendue = suivante;
+    return direction_vers(p, tete, suivante);
+}
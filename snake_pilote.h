@@ -0,0 +1,58 @@
+// pilote automatique: choisit la direction du serpent  chaque pas
+// (pour les parties d'endurance sans joueur et comme politique de rfrence)
+//
+// le pilote cherche un chemin vers le fruit bonus ou la nourriture par un parcours
+// en largeur qui tient compte du temps: une case du corps devient praticable quand
+// la queue l'a quitte. un chemin n'est suivi que si, une fois le fruit mang,
+// la queue reste atteignable; sinon le pilote suit le circuit qui passe par toutes
+// les cases, ou  dfaut la case d'o la queue est la plus loin
+// le chemin trouv est gard d'un pas  l'autre tant que la partie volue comme prvu
+// sur un niveau, les murs ne sont jamais praticables, le circuit n'est pas suivi et
+// un fruit bonus trop loin pour tre atteint  temps (distance_niveau) est cart sans recherche
+#ifndef SNAKE_PILOTE_H
+#define SNAKE_PILOTE_H
+
+#include "snake_moteur.h"
+
+typedef struct {
+    int largeur;
+    int hauteur;
+    // tat du serpent tel que le voit une recherche: une case marque par numero_etat
+    // ne peut tre occupe qu' partir du pas liberation[case] (1 = le prochain pas)
+    int* liberation;
+    uint32_t* etat_case;
+    uint32_t numero_etat;
+    // parcours en largeur (une case est vue si vu[case] == numero_recherche)
+    uint32_t* vu;
+    uint32_t numero_recherche;
+    int* precedent;
+    int* distance;
+    int* file;
+    // circuit passant une fois par chaque case (NULL si largeur et hauteur sont impaires)
+    int* cycle_suivant;
+    // niveau de la partie en cours (NULL: plateau sans mur)
+    const niveau* niveau;
+    // chemin prvu: cases  occuper, de la suivante jusqu'au fruit
+    int* chemin;
+    int longueur_chemin;
+    int etape;                     // indice de la prochaine case du chemin
+    // partie telle qu'elle doit tre si le chemin est encore valable
+    int tete_attendue;
+    int taille_attendue;           // longueur + croissance
+    position nourriture_attendue;
+    fruit fruits_attendus[nb_fruits_max];   // rserve de fruits bonus au moment du calcul
+    // statistiques
+    long long decisions;
+    long long plans;               // chemins calculs
+    long long reutilisations;      // pas jous sur un chemin dj calcul
+    long long secours;             // pas jous sans chemin sr vers un fruit
+    long long impasses;            // pas sans aucune case o la queue reste atteignable
+} pilote;
+
+pilote* creer_pilote(int largeur, int hauteur);
+void detruire_pilote(pilote* p);
+
+// choisit la direction du prochain pas ( mettre dans jeu->dir_actuelle)
+direction choisir_direction(pilote* p, const jeu_snake* jeu);
+
+#endif
@@ -0,0 +1,78 @@
+// profileur intgr (voir snake_profil.h)
+#include "snake_profil.h"
+
+#ifdef SNAKE_PROFIL
+
+#include <stdio.h>
+
+mesure_profil mesures_profil[nb_phases_profil];
+
+static const char* noms_phases[nb_phases_profil] = {
+    "image", "entrees", "simulation", "fruits", "nourriture",
+    "plateau", "cases", "textes", "affichage"
+};
+
+// fonction pour obtenir le nom d'une phase
+const char* nom_phase(phase_profil phase) {
+    return noms_phases[phase];
+}
+
+// fonction pour obtenir la plus grande dure d'une tranche (en nanosecondes)
+static double limite_tranche(int tranche) {
+    if (tranche < 4) return tranche + 1;
+    int octave = tranche / 4 + 1;
+    return (double)((uint64_t)(5 + tranche % 4) << (octave - 2));
+}
+
+// fonction pour obtenir la dure sous laquelle se trouve une fraction des mesures
+// (arrondie  la limite haute de sa tranche, jamais au-del du maximum)
+double quantile_phase(phase_profil phase, double fraction) {
+    const mesure_profil* m = &mesures_profil[phase];
+    if (m->nombre == 0) return 0;
+
+    long long seuil = (long long)(fraction * m->nombre);
+    if (seuil >= m->nombre) seuil = m->nombre - 1;
+
+    long long cumul = 0;
+    for (int t = 0; t < nb_tranches_profil; t++) {
+        cumul += m->tranches[t];
+        if (cumul > seuil) {
+            double limite = limite_tranche(t);
+            return (limite < m->max ? limite : m->max) / 1000.0;
+        }
+    }
+    return m->max / 1000.0;
+}
+
+// fonction pour obtenir la dure moyenne d'une phase
+double moyenne_phase(phase_profil phase) {
+    const mesure_profil* m = &mesures_profil[phase];
+    return m->nombre > 0 ? m->total / 1000.0 / m->nombre : 0;
+}
+
+// fonction pour obtenir la plus longue dure d'une phase
+double max_phase(phase_profil phase) {
+    return mesures_profil[phase].max / 1000.0;
+}
+
+// fonction pour crire le rsum des mesures
+int ecrire_profil(const char* chemin) {
+    FILE* fichier = fopen(chemin, "w");
+    if (fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return 1;
+    }
+
+    fprintf(fichier, "%-12s %10s %10s %10s %10s %10s  (microsecondes)\n",
+            "phase", "nombre", "moyenne", "p50", "p99", "max");
+    for (int p = 0; p < nb_phases_profil; p++) {
+        fprintf(fichier, "%-12s %10lld %10.1f %10.1f %10.1f %10.1f\n",
+                nom_phase(p), mesures_profil[p].nombre, moyenne_phase(p),
+                quantile_phase(p, 0.5), quantile_phase(p, 0.99), max_phase(p));
+    }
+
+    fclose(fichier);
+    return 0;
+}
+
+#endif
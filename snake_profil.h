@@ -0,0 +1,89 @@
+// profileur intgr: temps pass dans chaque phase d'une image et d'un pas
+// chaque mesure tombe dans un histogramme  tranches fixes (4 tranches par doublement
+// de dure) qui donne la mdiane, le 99e centile et le maximum sans rien allouer
+// activ seulement en compilant avec -DSNAKE_PROFIL; sinon les macros ne font rien
+// les mesures sont globales:  n'utiliser que dans le fil du jeu
+#ifndef SNAKE_PROFIL_H
+#define SNAKE_PROFIL_H
+
+#include <stdint.h>
+
+// phases mesures (les phases peuvent s'imbriquer, pas se rpter)
+typedef enum {
+    profil_image = 0,              // une image complte de la boucle principale
+    profil_entrees,                // lecture du clavier
+    profil_simulation,             // deplacer_serpent
+    profil_fruits,                 // mise_a_jour_fruits_bonus
+    profil_nourriture,             // placer_nourriture
+    profil_dessin_plateau,         // fond et grille
+    profil_dessin_cases,           // nourriture, fruit et serpent
+    profil_dessin_textes,          // score, messages
+    profil_affichage,              // EndDrawing (envoi  la carte et attente de l'cran)
+    nb_phases_profil
+} phase_profil;
+
+#define nb_tranches_profil 128     // dures jusqu' environ 8 secondes
+
+#ifdef SNAKE_PROFIL
+
+#include <time.h>
+
+// mesures d'une phase
+typedef struct {
+    uint64_t debut;                // instant du dbut en cours (nanosecondes)
+    long long nombre;              // nombre de mesures
+    uint64_t total;                // somme des dures (nanosecondes)
+    uint64_t max;                  // plus longue dure (nanosecondes)
+    uint32_t tranches[nb_tranches_profil];
+} mesure_profil;
+
+extern mesure_profil mesures_profil[nb_phases_profil];
+
+// horloge monotone en nanosecondes
+static inline uint64_t profil_maintenant(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+// numro de la tranche d'une dure: 4 tranches entre chaque puissance de 2
+static inline int tranche_profil(uint64_t duree) {
+    if (duree < 4) return (int)duree;
+    int octave = 63 - __builtin_clzll(duree);
+    int tranche = 4 * (octave - 1) + (int)((duree >> (octave - 2)) & 3);
+    return tranche < nb_tranches_profil ? tranche : nb_tranches_profil - 1;
+}
+
+static inline void debuter_phase(phase_profil phase) {
+    mesures_profil[phase].debut = profil_maintenant();
+}
+
+static inline void terminer_phase(phase_profil phase) {
+    mesure_profil* m = &mesures_profil[phase];
+    uint64_t duree = profil_maintenant() - m->debut;
+    m->nombre++;
+    m->total += duree;
+    if (duree > m->max) m->max = duree;
+    m->tranches[tranche_profil(duree)]++;
+}
+
+#define PROFIL_DEBUT(phase) debuter_phase(phase)
+#define PROFIL_FIN(phase) terminer_phase(phase)
+
+// lecture des mesures (en microsecondes)
+const char* nom_phase(phase_profil phase);
+double quantile_phase(phase_profil phase, double fraction);   // 0.5 = mdiane
+double moyenne_phase(phase_profil phase);
+double max_phase(phase_profil phase);
+
+// crit un rsum de toutes les phases; retourne 0 si tout s'est bien pass
+int ecrire_profil(const char* chemin);
+
+#else
+
+#define PROFIL_DEBUT(phase) ((void)0)
+#define PROFIL_FIN(phase) ((void)0)
+
+#endif
+
+#endif
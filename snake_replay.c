@@ -0,0 +1,392 @@
+// enregistrement et relecture d'une partie (voir snake_replay.h)
+#include "snake_replay.h"
+#include "snake_sauvegarde.h"
+#include "snake_niveau.h"
+#include <stdlib.h>
+#include <string.h>
+
+// fonction pour crire un entier positif en 7 bits par octet
+// (le bit de poids fort indique qu'un autre octet suit)
+static void ecrire_varint(FILE* fichier, uint64_t valeur) {
+    while (valeur >= 0x80) {
+        fputc((int)(valeur & 0x7f) | 0x80, fichier);
+        valeur >>= 7;
+    }
+    fputc((int)valeur, fichier);
+}
+
+// fonction pour lire un entier crit par ecrire_varint; retourne 0 si russi
+static int lire_varint(FILE* fichier, uint64_t* valeur) {
+    *valeur = 0;
+    for (int decalage = 0; decalage < 64; decalage += 7) {
+        int octet = fgetc(fichier);
+        if (octet == EOF) return 1;
+        *valeur |= (uint64_t)(octet & 0x7f) << decalage;
+        if (!(octet & 0x80)) return 0;
+    }
+    return 1;
+}
+
+// fonction pour crire la carte d'un niveau ('#' pour un mur, '.' sinon, une ligne par range)
+// les cases mures au chargement le sont aussi dans la carte: relue, elle donne les mmes murs
+static void ecrire_carte(FILE* fichier, const niveau* niv) {
+    for (int y = 0; y < niv->hauteur; y++) {
+        for (int x = 0; x < niv->largeur; x++) {
+            fputc(niv->murs[y * niv->largeur + x] ? '#' : '.', fichier);
+        }
+        fputc('\n', fichier);
+    }
+}
+
+// fonction pour commencer l'enregistrement d'une partie qui vient d'tre cre
+enregistreur_replay* commencer_replay(const char* chemin, const jeu_snake* jeu, uint64_t graine, int intervalle_images) {
+    enregistreur_replay* rec = (enregistreur_replay*)calloc(1, sizeof(enregistreur_replay));
+    if (rec == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour l'enregistrement\n");
+        return NULL;
+    }
+
+    rec->fichier = fopen(chemin, "wb");
+    if (rec->fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        free(rec);
+        return NULL;
+    }
+
+    entete_replay entete = { 0 };
+    entete.magie = magie_replay;
+    entete.largeur = jeu->largeur;
+    entete.hauteur = jeu->hauteur;
+    entete.intervalle_images = intervalle_images > 0 ? intervalle_images : intervalle_images_defaut;
+    entete.graine = graine;
+    if (jeu->niveau != NULL) {
+        entete.taille_niveau = (uint64_t)(jeu->niveau->largeur + 1) * jeu->niveau->hauteur;
+    }
+    fwrite(&entete, sizeof(entete), 1, rec->fichier);
+    if (jeu->niveau != NULL) {
+        ecrire_carte(rec->fichier, jeu->niveau);
+    }
+
+    rec->intervalle_images = entete.intervalle_images;
+    rec->dernier_pas = jeu->nb_pas;
+    rec->pas_derniere_image = jeu->nb_pas;
+    rec->prochaine_image = jeu->nb_pas + rec->intervalle_images;
+    rec->derniere_dir = jeu->dir_actuelle;
+    return rec;
+}
+
+// fonction pour noter l'tat avant un pas: la direction si elle a chang,
+// et une image complte tous les intervalle_images pas
+int noter_pas_replay(enregistreur_replay* rec, const jeu_snake* jeu) {
+    if (rec == NULL) return 0;
+
+    if (jeu->dir_actuelle != rec->derniere_dir) {
+        fputc(jeu->dir_actuelle, rec->fichier);
+        ecrire_varint(rec->fichier, jeu->nb_pas - rec->dernier_pas);
+        rec->dernier_pas = jeu->nb_pas;
+        rec->derniere_dir = jeu->dir_actuelle;
+    }
+
+    if (jeu->nb_pas >= rec->prochaine_image) {
+        // une image de plusieurs mgaoctets n'est crite que tous les taille / octets_images_par_pas pas
+        size_t taille = taille_image(jeu);
+        int ecart_min = (int)(taille / octets_images_par_pas);
+        if (jeu->nb_pas - rec->pas_derniere_image < ecart_min) {
+            rec->prochaine_image = rec->pas_derniere_image + ecart_min;
+            return ferror(rec->fichier) ? 1 : 0;
+        }
+
+        // le tampon ne grandit qu'avec l'tat du jeu, pas avec la dure de la partie
+        if (taille > rec->taille_tampon) {
+            unsigned char* image = (unsigned char*)realloc(rec->image, taille);
+            if (image == NULL) {
+                printf("erreur: impossible d'allouer de la mmoire pour l'image\n");
+                return 1;
+            }
+            rec->image = image;
+            rec->taille_tampon = taille;
+        }
+        ecrire_image(jeu, rec->image);
+
+        fputc(etiquette_image, rec->fichier);
+        ecrire_varint(rec->fichier, jeu->nb_pas - rec->dernier_pas);
+        ecrire_varint(rec->fichier, taille);
+        fwrite(rec->image, 1, taille, rec->fichier);
+        rec->dernier_pas = jeu->nb_pas;
+        rec->pas_derniere_image = jeu->nb_pas;
+        rec->prochaine_image = jeu->nb_pas + rec->intervalle_images;
+    }
+
+    return ferror(rec->fichier) ? 1 : 0;
+}
+
+// fonction pour terminer l'enregistrement (le score final sert  la vrification)
+void terminer_replay(enregistreur_replay* rec, const jeu_snake* jeu) {
+    if (rec == NULL) return;
+
+    if (jeu != NULL) {
+        fputc(etiquette_fin, rec->fichier);
+        ecrire_varint(rec->fichier, jeu->nb_pas - rec->dernier_pas);
+        ecrire_varint(rec->fichier, jeu->score);
+    }
+    fclose(rec->fichier);
+    free(rec->image);
+    free(rec);
+}
+
+// un enregistrement lu dans le fichier
+typedef struct {
+    int etiquette;                 // direction, etiquette_image ou etiquette_fin (-1  la fin du fichier)
+    int pas;
+    uint64_t valeur;               // taille de l'image ou score final
+    long position;                 // dbut de l'image dans le fichier
+} enregistrement;
+
+// fonction pour lire l'enregistrement suivant (les images sont sautes)
+// pas contient le pas de l'enregistrement prcdent
+static void lire_enregistrement(FILE* fichier, enregistrement* e) {
+    uint64_t ecart;
+    int etiquette = fgetc(fichier);
+
+    if (etiquette == EOF || etiquette > etiquette_fin || lire_varint(fichier, &ecart) != 0) {
+        e->etiquette = -1;
+        return;
+    }
+    e->etiquette = etiquette;
+    e->pas += (int)ecart;
+
+    if (etiquette == etiquette_image || etiquette == etiquette_fin) {
+        if (lire_varint(fichier, &e->valeur) != 0) {
+            e->etiquette = -1;
+            return;
+        }
+    }
+    if (etiquette == etiquette_image) {
+        e->position = ftell(fichier);
+        fseek(fichier, (long)e->valeur, SEEK_CUR);
+    }
+}
+
+// fonction pour ouvrir un enregistrement et reprer ses images
+lecteur_replay* ouvrir_replay(const char* chemin) {
+    lecteur_replay* lec = (lecteur_replay*)calloc(1, sizeof(lecteur_replay));
+    if (lec == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour la relecture\n");
+        return NULL;
+    }
+
+    lec->fichier = fopen(chemin, "rb");
+    if (lec->fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        free(lec);
+        return NULL;
+    }
+    if (fread(&lec->entete, sizeof(entete_replay), 1, lec->fichier) != 1 || lec->entete.magie != magie_replay) {
+        printf("erreur: %s n'est pas un enregistrement de partie\n", chemin);
+        fermer_replay(lec);
+        return NULL;
+    }
+
+    // le niveau de la partie, reconstruit depuis sa carte
+    if (lec->entete.taille_niveau > 0) {
+        size_t taille = (size_t)lec->entete.taille_niveau;
+        char* carte = (char*)malloc(taille);
+        if (carte == NULL) {
+            printf("erreur: impossible d'allouer de la mmoire pour la carte du niveau\n");
+            fermer_replay(lec);
+            return NULL;
+        }
+        if (fread(carte, 1, taille, lec->fichier) == taille) {
+            lec->niveau = lire_niveau(carte, taille);
+        } else {
+            printf("erreur: carte du niveau incomplte dans %s\n", chemin);
+        }
+        free(carte);
+        if (lec->niveau == NULL || lec->niveau->largeur != lec->entete.largeur || lec->niveau->hauteur != lec->entete.hauteur) {
+            printf("erreur: %s contient une carte de niveau invalide\n", chemin);
+            fermer_replay(lec);
+            return NULL;
+        }
+    }
+    lec->debut = ftell(lec->fichier);
+    lec->pas_final = -1;
+
+    // parcourir le fichier une fois pour trouver les images et la fin
+    enregistrement e = { 0 };
+    int capacite = 0;
+    for (lire_enregistrement(lec->fichier, &e); e.etiquette >= 0; lire_enregistrement(lec->fichier, &e)) {
+        if (e.etiquette == etiquette_image) {
+            if (lec->nb_images == capacite) {
+                capacite = capacite > 0 ? capacite * 2 : 16;
+                index_image* images = (index_image*)realloc(lec->images, capacite * sizeof(index_image));
+                if (images == NULL) {
+                    printf("erreur: impossible d'allouer de la mmoire pour la relecture\n");
+                    fermer_replay(lec);
+                    return NULL;
+                }
+                lec->images = images;
+            }
+            lec->images[lec->nb_images].pas = e.pas;
+            lec->images[lec->nb_images].position = e.position;
+            lec->images[lec->nb_images].taille = (size_t)e.valeur;
+            lec->nb_images++;
+        } else if (e.etiquette == etiquette_fin) {
+            lec->pas_final = e.pas;
+            lec->score_final = (int)e.valeur;
+            break;
+        }
+    }
+
+    return lec;
+}
+
+// fonction pour fermer un enregistrement
+void fermer_replay(lecteur_replay* lec) {
+    if (lec == NULL) return;
+
+    fclose(lec->fichier);
+    free(lec->images);
+    detruire_niveau(lec->niveau);
+    free(lec);
+}
+
+// fonction pour lire une image du fichier
+static jeu_snake* charger_image(lecteur_replay* lec, const index_image* image) {
+    unsigned char* octets = (unsigned char*)malloc(image->taille);
+    if (octets == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour l'image\n");
+        return NULL;
+    }
+
+    jeu_snake* jeu = NULL;
+    fseek(lec->fichier, image->position, SEEK_SET);
+    if (fread(octets, 1, image->taille, lec->fichier) == image->taille) {
+        jeu = lire_image(octets, image->taille);
+    }
+    free(octets);
+
+    // les murs sont dans l'image; le niveau est rattach pour les parties suivantes
+    if (jeu != NULL && choisir_niveau(jeu, lec->niveau) != 0) {
+        detruire_jeu(jeu);
+        jeu = NULL;
+    }
+    return jeu;
+}
+
+// fonction pour recrer la partie au dbut de l'enregistrement (avec les murs du niveau)
+// comme le jeu: creer_jeu, puis reinitialiser_jeu avec la mme graine une fois le niveau choisi
+static jeu_snake* recreer_partie(const lecteur_replay* lec) {
+    jeu_snake* jeu = creer_jeu(lec->entete.largeur, lec->entete.hauteur, lec->entete.graine);
+    if (jeu == NULL) {
+        return NULL;
+    }
+    if (lec->niveau != NULL) {
+        if (choisir_niveau(jeu, lec->niveau) != 0) {
+            detruire_jeu(jeu);
+            return NULL;
+        }
+        reinitialiser_jeu(jeu, lec->entete.graine);  // poser les murs
+    }
+    jeu->en_menu = 0;
+    return jeu;
+}
+
+// fonction pour rejouer une partie jusqu'au pas demand
+// le fichier doit tre plac juste aprs l'enregistrement du pas e->pas;
+// avec verifier, chaque image rencontre est compare  la partie rejoue
+// retourne 0 si tout s'est bien pass
+static int rejouer(lecteur_replay* lec, jeu_snake* jeu, enregistrement* e, int pas, int verifier) {
+    lire_enregistrement(lec->fichier, e);
+
+    while (1) {
+        // appliquer les enregistrements nots avant le pas en cours
+        while (e->etiquette >= 0 && e->etiquette != etiquette_fin && e->pas <= jeu->nb_pas) {
+            if (e->etiquette < etiquette_image) {
+                jeu->dir_actuelle = (direction)e->etiquette;
+            } else if (verifier) {
+                index_image image = { e->pas, e->position, (size_t)e->valeur };
+                long suite = ftell(lec->fichier);
+                jeu_snake* attendu = charger_image(lec, &image);
+                int identique = attendu != NULL && jeux_identiques(attendu, jeu);
+                detruire_jeu(attendu);
+                fseek(lec->fichier, suite, SEEK_SET);
+                if (!identique) {
+                    printf("erreur: la partie rejoue diffre de l'image du pas %d\n", e->pas);
+                    return 1;
+                }
+            }
+            lire_enregistrement(lec->fichier, e);
+        }
+
+        if (jeu->nb_pas >= pas || jeu->game_over) {
+            return 0;
+        }
+        deplacer_serpent(jeu);
+    }
+}
+
+// fonction pour obtenir l'tat de la partie juste avant un pas
+jeu_snake* aller_au_pas(lecteur_replay* lec, int pas) {
+    if (pas < 0 || (lec->pas_final >= 0 && pas > lec->pas_final)) {
+        return NULL;
+    }
+
+    // reprendre depuis la dernire image qui prcde le pas, ou depuis la graine
+    int premiere = 0;
+    int derniere = lec->nb_images - 1;
+    int trouvee = -1;
+    while (premiere <= derniere) {
+        int milieu = (premiere + derniere) / 2;
+        if (lec->images[milieu].pas <= pas) {
+            trouvee = milieu;
+            premiere = milieu + 1;
+        } else {
+            derniere = milieu - 1;
+        }
+    }
+
+    jeu_snake* jeu;
+    enregistrement e = { 0 };
+    if (trouvee >= 0) {
+        jeu = charger_image(lec, &lec->images[trouvee]);
+        e.pas = lec->images[trouvee].pas;
+        fseek(lec->fichier, lec->images[trouvee].position + (long)lec->images[trouvee].taille, SEEK_SET);
+    } else {
+        jeu = recreer_partie(lec);
+        fseek(lec->fichier, lec->debut, SEEK_SET);
+    }
+    if (jeu == NULL) {
+        return NULL;
+    }
+
+    rejouer(lec, jeu, &e, pas, 0);
+    return jeu;
+}
+
+// fonction pour rejouer toute la partie depuis la graine et vrifier le score final
+int verifier_replay(lecteur_replay* lec, int comparer_images, int* score, double* secondes) {
+    if (lec->pas_final < 0) {
+        printf("erreur: l'enregistrement n'est pas termin\n");
+        return 1;
+    }
+
+    jeu_snake* jeu = recreer_partie(lec);
+    if (jeu == NULL) {
+        return 1;
+    }
+
+    double debut = horloge_secondes();
+    enregistrement e = { 0 };
+    fseek(lec->fichier, lec->debut, SEEK_SET);
+    int erreur = rejouer(lec, jeu, &e, lec->pas_final, comparer_images);
+    *secondes = horloge_secondes() - debut;
+    *score = jeu->score;
+
+    if (erreur == 0 && (jeu->nb_pas != lec->pas_final || jeu->score != lec->score_final)) {
+        printf("erreur: score rejou %d au pas %d, score enregistr %d au pas %d\n",
+               jeu->score, jeu->nb_pas, lec->score_final, lec->pas_final);
+        erreur = 1;
+    }
+    detruire_jeu(jeu);
+    return erreur;
+}
@@ -0,0 +1,86 @@
+// enregistrement et relecture d'une partie
+// le fichier contient la graine, puis seulement les pas o dir_actuelle a chang
+// (cart depuis l'vnement prcdent en entier de taille variable), et  intervalle
+// rgulier une image complte du jeu pour pouvoir reprendre la partie n'importe o
+// l'enregistrement crit au fil de l'eau: sa mmoire ne grandit pas avec la partie
+//
+// format: en-tte (entete_replay), carte du niveau (taille_niveau octets, au format
+// de snake_niveau.h: la relecture reconstruit le mme niveau), puis une suite d'enregistrements
+//   0  3: changement de direction (la direction), suivi de l'cart en pas
+//   etiquette_image: cart en pas, taille de l'image, image (snake_sauvegarde.h)
+//   etiquette_fin:   cart en pas, score final
+#ifndef SNAKE_REPLAY_H
+#define SNAKE_REPLAY_H
+
+#include "snake_moteur.h"
+#include <stdio.h>
+
+#define magie_replay 0x32524e53u   // "SNR2" (carte du niveau aprs l'en-tte)
+#define etiquette_image 4
+#define etiquette_fin 5
+#define intervalle_images_defaut 1000   // pas entre deux images compltes
+#define octets_images_par_pas 64        // sur un grand plateau, les images sont espaces
+                                        // pour ne pas dpasser ce dbit moyen
+
+// en-tte du fichier
+typedef struct {
+    uint32_t magie;
+    int32_t largeur;               // plateau de la partie
+    int32_t hauteur;
+    int32_t intervalle_images;
+    uint64_t graine;               // graine donne  creer_jeu
+    uint64_t taille_niveau;        // octets de la carte qui suit l'en-tte (0: plateau sans mur)
+} entete_replay;
+
+// enregistrement en cours
+typedef struct {
+    FILE* fichier;
+    int intervalle_images;
+    int dernier_pas;               // pas du dernier enregistrement crit
+    int pas_derniere_image;        // pas de la dernire image crite
+    int prochaine_image;           // pas o une image sera envisage
+    direction derniere_dir;        // direction au dernier changement
+    unsigned char* image;          // tampon rutilis pour les images
+    size_t taille_tampon;
+} enregistreur_replay;
+
+// position d'une image dans le fichier
+typedef struct {
+    int pas;
+    long position;                 // dbut de l'image dans le fichier
+    size_t taille;
+} index_image;
+
+// relecture d'un fichier
+typedef struct {
+    FILE* fichier;
+    entete_replay entete;
+    niveau* niveau;                // niveau relu dans la carte (NULL: plateau sans mur)
+    long debut;                    // premier enregistrement aprs l'en-tte
+    index_image* images;           // images trouves en parcourant le fichier
+    int nb_images;
+    int pas_final;                 // -1 si la partie n'a pas t termine
+    int score_final;
+} lecteur_replay;
+
+// enregistrement: commencer_replay juste aprs creer_jeu ou reinitialiser_jeu (la carte du niveau
+// du jeu est recopie dans le fichier), noter_pas_replay juste avant chaque deplacer_serpent,
+// terminer_replay  la fin
+enregistreur_replay* commencer_replay(const char* chemin, const jeu_snake* jeu, uint64_t graine, int intervalle_images);
+int noter_pas_replay(enregistreur_replay* rec, const jeu_snake* jeu);
+void terminer_replay(enregistreur_replay* rec, const jeu_snake* jeu);
+
+// relecture
+lecteur_replay* ouvrir_replay(const char* chemin);
+void fermer_replay(lecteur_replay* lec);
+
+// tat de la partie juste avant le pas demand (reprise depuis l'image prcdente)
+// retourne NULL si le pas n'existe pas dans l'enregistrement
+jeu_snake* aller_au_pas(lecteur_replay* lec, int pas);
+
+// rejoue toute la partie depuis la graine sans fentre, aussi vite que possible;
+// avec comparer_images, chaque image est aussi compare  la partie rejoue (plus lent)
+// retourne 0 si le score final est celui de l'enregistrement
+int verifier_replay(lecteur_replay* lec, int comparer_images, int* score, double* secondes);
+
+#endif
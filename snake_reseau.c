@@ -0,0 +1,458 @@
+// parties  plusieurs en rseau (voir snake_reseau.h)
+#include "snake_reseau.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#define masque_historique (historique_reseau - 1)
+
+// fonction pour crer une session
+session_reseau* creer_session(int nb_joueurs, int local, int delai, int largeur, int hauteur,
+                              uint64_t graine, transport_reseau* transport) {
+    if (nb_joueurs < 1 || nb_joueurs > nb_joueurs_max || local < 0 || local >= nb_joueurs ||
+        delai < 0 || delai >= retour_max) {
+        printf("erreur: session invalide (%d joueurs, joueur %d, delai %d)\n", nb_joueurs, local, delai);
+        return NULL;
+    }
+    session_reseau* s = (session_reseau*)calloc(1, sizeof(session_reseau));
+    if (s == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour la session\n");
+        return NULL;
+    }
+    s->nb_joueurs = nb_joueurs;
+    s->local = local;
+    s->delai = delai;
+    s->transport = transport;
+    s->premier_faux = -1;
+
+    // un plateau par joueur, plus ses sauvegardes (alloues une fois, recopies  chaque pas)
+    int erreur = 0;
+    for (int j = 0; j < nb_joueurs; j++) {
+        s->jeux[j] = creer_jeu(largeur, hauteur, graine);
+        erreur |= s->jeux[j] == NULL;
+        if (s->jeux[j] != NULL) s->jeux[j]->en_menu = 0;
+        for (int k = 0; k < historique_reseau; k++) {
+            s->sauvegardes[k][j] = allouer_jeu(largeur, hauteur);
+            erreur |= s->sauvegardes[k][j] == NULL;
+        }
+    }
+    if (erreur) {
+        detruire_session(s);
+        return NULL;
+    }
+
+    // aucune entre pendant les delai premiers pas: ils sont connus de tous d'avance
+    for (int k = 0; k < historique_reseau; k++) {
+        for (int j = 0; j < nb_joueurs; j++) {
+            s->pas_entrees[k][j] = k < delai ? k : -1;
+            s->entrees[k][j] = -1;
+        }
+    }
+    for (int j = 0; j < nb_joueurs; j++) {
+        s->recu[j] = delai - 1;
+        s->accuse[j] = delai - 1;
+    }
+    return s;
+}
+
+// fonction pour librer une session (le transport reste  fermer par l'appelant)
+void detruire_session(session_reseau* s) {
+    if (s == NULL) return;
+    for (int j = 0; j < nb_joueurs_max; j++) {
+        detruire_jeu(s->jeux[j]);
+        for (int k = 0; k < historique_reseau; k++) {
+            detruire_jeu(s->sauvegardes[k][j]);
+        }
+    }
+    free(s);
+}
+
+// fonction pour obtenir la direction prise avec une entre
+// (les entres ngatives et les demi-tours sont ignors, comme au clavier)
+static direction direction_effective(int action, direction actuelle) {
+    return action < 0 || (action ^ actuelle) == 1 ? actuelle : (direction)action;
+}
+
+// fonction pour jouer le pas k sur tous les plateaux (en sauvegardant l'tat d'avant)
+// une entre inconnue est prdite: garder la direction
+static void jouer_pas(session_reseau* s, int k) {
+    int place = k & masque_historique;
+    for (int j = 0; j < s->nb_joueurs; j++) {
+        jeu_snake* jeu = s->jeux[j];
+        copier_jeu(s->sauvegardes[place][j], jeu);
+
+        int action = s->pas_entrees[place][j] == k ? s->entrees[place][j] : -1;
+        s->utilisees[place][j] = (int8_t)action;
+        jeu->dir_actuelle = direction_effective(action, jeu->dir_actuelle);
+        deplacer_serpent(jeu);
+    }
+}
+
+// fonction pour lire un message reu et noter les entres d'un autre joueur
+static void lire_message(session_reseau* s, const message_reseau* m, int taille) {
+    if (taille != (int)sizeof(message_reseau) || m->magie != magie_reseau ||
+        m->joueur >= s->nb_joueurs || m->joueur == s->local || m->nb_entrees > entrees_par_message) {
+        return;  // message d'une autre application ou abm
+    }
+    int j = m->joueur;
+    s->mesures.messages_recus++;
+    if (m->accuse > s->accuse[j]) {
+        s->accuse[j] = m->accuse;
+    }
+
+    for (int i = 0; i < m->nb_entrees; i++) {
+        int k = m->premier_pas + i;
+        // dj reue, ou trop loin devant pour l'historique
+        if (k <= s->recu[j] || k >= s->pas_courant + retour_max) continue;
+
+        int place = k & masque_historique;
+        s->entrees[place][j] = m->entrees[i];
+        s->pas_entrees[place][j] = k;
+        // pas dj jou avec une entre qui change la direction autrement: il faudra le rejouer
+        // (la direction d'avant le pas est celle de la sauvegarde; si elle vient elle-mme
+        // d'une mauvaise prdiction, un pas plus ancien est dj  rejouer)
+        direction avant = s->sauvegardes[place][j]->dir_actuelle;
+        if (k < s->pas_courant && direction_effective(m->entrees[i], avant) !=
+                                  direction_effective(s->utilisees[place][j], avant)) {
+            s->mesures.predictions_fausses++;
+            if (s->premier_faux < 0 || k < s->premier_faux) {
+                s->premier_faux = k;
+            }
+        }
+    }
+
+    // avancer tant qu'il n'y a pas de trou
+    while (s->pas_entrees[(s->recu[j] + 1) & masque_historique][j] == s->recu[j] + 1) {
+        s->recu[j]++;
+    }
+}
+
+// fonction pour revenir au plus ancien pas mal prdit et rejouer jusqu'au pas courant
+static void revenir_en_arriere(session_reseau* s) {
+    if (s->premier_faux < 0) return;
+
+    double debut = horloge_secondes();
+    int depart = s->premier_faux;
+    int profondeur = s->pas_courant - depart;
+    for (int j = 0; j < s->nb_joueurs; j++) {
+        copier_jeu(s->jeux[j], s->sauvegardes[depart & masque_historique][j]);
+    }
+    for (int k = depart; k < s->pas_courant; k++) {
+        jouer_pas(s, k);
+    }
+    s->premier_faux = -1;
+
+    double duree = horloge_secondes() - debut;
+    mesures_reseau* m = &s->mesures;
+    m->retours++;
+    m->pas_rejoues += profondeur;
+    m->secondes_rejeu += duree;
+    if (profondeur > m->profondeur_max) m->profondeur_max = profondeur;
+    if (duree > m->rejeu_max) m->rejeu_max = duree;
+}
+
+// fonction pour envoyer  chaque autre joueur nos entres qu'il n'a pas encore accuses
+static void envoyer_entrees(session_reseau* s) {
+    int derniere = s->recu[s->local];   // dernire entre locale donne
+    for (int j = 0; j < s->nb_joueurs; j++) {
+        if (j == s->local) continue;
+
+        message_reseau m;
+        memset(&m, 0, sizeof(m));
+        m.magie = magie_reseau;
+        m.joueur = (uint8_t)s->local;
+        m.premier_pas = s->accuse[j] + 1;
+        m.accuse = s->recu[j];
+        int nombre = derniere - s->accuse[j];
+        m.nb_entrees = (uint8_t)(nombre < entrees_par_message ? (nombre > 0 ? nombre : 0) : entrees_par_message);
+        for (int i = 0; i < m.nb_entrees; i++) {
+            m.entrees[i] = s->entrees[(m.premier_pas + i) & masque_historique][s->local];
+        }
+        if (s->transport->envoyer(s->transport, j, &m, sizeof(m)) == 0) {
+            s->mesures.messages_envoyes++;
+        }
+    }
+}
+
+// fonction pour lire tous les messages arrivs et corriger les pas mal prdits
+static void recevoir_entrees(session_reseau* s) {
+    message_reseau m;
+    int taille;
+    while ((taille = s->transport->recevoir(s->transport, &m, sizeof(m))) > 0) {
+        lire_message(s, &m, taille);
+    }
+    revenir_en_arriere(s);
+}
+
+// fonction pour jouer une image de la session
+int avancer_session(session_reseau* s, int action) {
+    recevoir_entrees(s);
+
+    // attendre si une entre distante a trop de retard pour l'historique
+    int plus_ancien = s->pas_courant;
+    for (int j = 0; j < s->nb_joueurs; j++) {
+        if (s->recu[j] + 1 < plus_ancien) plus_ancien = s->recu[j] + 1;
+    }
+    int joue = s->pas_courant - plus_ancien < retour_max;
+    if (joue) {
+        // l'entre locale est connue de nous tout de suite, et joue delai pas plus tard
+        int k = s->pas_courant + s->delai;
+        s->entrees[k & masque_historique][s->local] = (int8_t)action;
+        s->pas_entrees[k & masque_historique][s->local] = k;
+        s->recu[s->local] = k;
+
+        jouer_pas(s, s->pas_courant);
+        s->pas_courant++;
+        s->mesures.pas++;
+    } else {
+        s->mesures.attentes++;
+    }
+
+    envoyer_entrees(s);
+    return joue;
+}
+
+// fonction pour changer les entres sans jouer de pas (par exemple  la fin d'une partie limite)
+void synchroniser_session(session_reseau* s) {
+    recevoir_entrees(s);
+    envoyer_entrees(s);
+}
+
+// fonction pour savoir si toutes les entres jusqu'au pas courant sont connues
+int session_confirmee(const session_reseau* s) {
+    for (int j = 0; j < s->nb_joueurs; j++) {
+        if (s->recu[j] < s->pas_courant - 1) return 0;
+    }
+    return s->premier_faux < 0;
+}
+
+// fonction pour savoir si la partie est finie pour tout le monde
+int session_terminee(const session_reseau* s) {
+    for (int j = 0; j < s->nb_joueurs; j++) {
+        if (!s->jeux[j]->game_over) return 0;
+    }
+    return session_confirmee(s);
+}
+
+// boucle locale: les messages restent en mmoire jusqu' leur image d'arrive
+typedef struct {
+    int destination;
+    long long arrivee;             // image o le message peut tre reu
+    int taille;
+    unsigned char octets[sizeof(message_reseau)];
+} message_en_vol;
+
+struct boucle_locale {
+    int nb_joueurs;
+    int latence;                   // images entre l'envoi et l'arrive
+    int gigue;                     // images de retard en plus, au hasard (peut changer l'ordre)
+    int pertes_pour_mille;
+    generateur hasard;
+    long long image;
+    message_en_vol* messages;
+    int nb_messages;
+    int capacite;
+    transport_reseau points[nb_joueurs_max];
+};
+
+// fonction pour mettre un message en vol dans la boucle
+static int envoyer_boucle(transport_reseau* t, int destination, const void* octets, int taille) {
+    boucle_locale* b = (boucle_locale*)t->donnees;
+    if (taille > (int)sizeof(message_reseau)) return 1;
+    if (valeur_aleatoire(&b->hasard, 0, 999) < b->pertes_pour_mille) {
+        return 0;  // perdu en route (l'expditeur ne le sait pas)
+    }
+    if (b->nb_messages == b->capacite) {
+        int capacite = b->capacite > 0 ? b->capacite * 2 : 64;
+        message_en_vol* messages = (message_en_vol*)realloc(b->messages, capacite * sizeof(message_en_vol));
+        if (messages == NULL) return 1;
+        b->messages = messages;
+        b->capacite = capacite;
+    }
+    message_en_vol* m = &b->messages[b->nb_messages++];
+    m->destination = destination;
+    m->arrivee = b->image + b->latence + (b->gigue > 0 ? valeur_aleatoire(&b->hasard, 0, b->gigue) : 0);
+    m->taille = taille;
+    memcpy(m->octets, octets, taille);
+    return 0;
+}
+
+// fonction pour recevoir le plus ancien message arriv
+static int recevoir_boucle(transport_reseau* t, void* octets, int taille_max) {
+    boucle_locale* b = (boucle_locale*)t->donnees;
+    for (int i = 0; i < b->nb_messages; i++) {
+        message_en_vol* m = &b->messages[i];
+        if (m->destination != t->joueur || m->arrivee > b->image) continue;
+
+        int taille = m->taille < taille_max ? m->taille : taille_max;
+        memcpy(octets, m->octets, taille);
+        memmove(m, m + 1, (b->nb_messages - i - 1) * sizeof(message_en_vol));
+        b->nb_messages--;
+        return taille;
+    }
+    return 0;
+}
+
+// les points de la boucle sont librs avec la boucle
+static void fermer_boucle(transport_reseau* t) {
+    (void)t;
+}
+
+// fonction pour crer une boucle locale entre nb_joueurs joueurs
+boucle_locale* creer_boucle_locale(int nb_joueurs, int latence, int gigue, int pertes_pour_mille, uint64_t graine) {
+    boucle_locale* b = (boucle_locale*)calloc(1, sizeof(boucle_locale));
+    if (b == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour la boucle locale\n");
+        return NULL;
+    }
+    b->nb_joueurs = nb_joueurs;
+    b->latence = latence;
+    b->gigue = gigue;
+    b->pertes_pour_mille = pertes_pour_mille;
+    initialiser_generateur(&b->hasard, graine);
+    for (int j = 0; j < nb_joueurs_max; j++) {
+        b->points[j] = (transport_reseau){ envoyer_boucle, recevoir_boucle, fermer_boucle, b, j };
+    }
+    return b;
+}
+
+// fonction pour obtenir le point de la boucle d'un joueur
+transport_reseau* transport_boucle(boucle_locale* boucle, int joueur) {
+    return &boucle->points[joueur];
+}
+
+// fonction pour passer  l'image suivante
+void avancer_boucle(boucle_locale* boucle) {
+    boucle->image++;
+}
+
+void detruire_boucle_locale(boucle_locale* boucle) {
+    if (boucle == NULL) return;
+    free(boucle->messages);
+    free(boucle);
+}
+
+// transport UDP: une prise non bloquante, l'adresse de chaque joueur
+typedef struct {
+#ifdef _WIN32
+    SOCKET prise;
+#else
+    int prise;
+#endif
+    int nb_joueurs;
+    struct sockaddr_in adresses[nb_joueurs_max];
+    transport_reseau transport;
+} liaison_udp;
+
+// fonction pour envoyer un message  un joueur
+static int envoyer_udp(transport_reseau* t, int destination, const void* octets, int taille) {
+    liaison_udp* l = (liaison_udp*)t->donnees;
+    int envoye = sendto(l->prise, (const char*)octets, taille, 0,
+                        (const struct sockaddr*)&l->adresses[destination], sizeof(struct sockaddr_in));
+    return envoye == taille ? 0 : 1;
+}
+
+// fonction pour recevoir un message s'il y en a un (sans attendre)
+static int recevoir_udp(transport_reseau* t, void* octets, int taille_max) {
+    liaison_udp* l = (liaison_udp*)t->donnees;
+    int recu = recvfrom(l->prise, (char*)octets, taille_max, 0, NULL, NULL);
+    return recu > 0 ? recu : 0;
+}
+
+// fonction pour fermer la prise
+static void fermer_udp(transport_reseau* t) {
+    liaison_udp* l = (liaison_udp*)t->donnees;
+#ifdef _WIN32
+    closesocket(l->prise);
+    WSACleanup();
+#else
+    close(l->prise);
+#endif
+    free(l);
+}
+
+// fonction pour trouver l'adresse d'un joueur ("hote:port")
+static int lire_adresse(const char* texte, struct sockaddr_in* adresse) {
+    char hote[256];
+    int port;
+    const char* separation = strrchr(texte, ':');
+    if (separation == NULL || separation - texte >= (int)sizeof(hote)) return 1;
+    memcpy(hote, texte, separation - texte);
+    hote[separation - texte] = '\0';
+    port = atoi(separation + 1);
+
+    struct addrinfo indices;
+    struct addrinfo* resultat = NULL;
+    memset(&indices, 0, sizeof(indices));
+    indices.ai_family = AF_INET;
+    indices.ai_socktype = SOCK_DGRAM;
+    if (port <= 0 || port > 65535 || getaddrinfo(hote, NULL, &indices, &resultat) != 0) return 1;
+
+    *adresse = *(struct sockaddr_in*)resultat->ai_addr;
+    adresse->sin_port = htons((uint16_t)port);
+    freeaddrinfo(resultat);
+    return 0;
+}
+
+// fonction pour ouvrir le transport UDP d'un joueur: la prise coute sur le port de son adresse
+transport_reseau* ouvrir_udp(int joueur, int nb_joueurs, const char** adresses) {
+    liaison_udp* l = (liaison_udp*)calloc(1, sizeof(liaison_udp));
+    if (l == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour le rseau\n");
+        return NULL;
+    }
+#ifdef _WIN32
+    WSADATA infos;
+    if (WSAStartup(MAKEWORD(2, 2), &infos) != 0) {
+        printf("erreur: rseau indisponible\n");
+        free(l);
+        return NULL;
+    }
+#endif
+
+    for (int j = 0; j < nb_joueurs; j++) {
+        if (lire_adresse(adresses[j], &l->adresses[j]) != 0) {
+            printf("erreur: adresse invalide: %s\n", adresses[j]);
+#ifdef _WIN32
+            WSACleanup();
+#endif
+            free(l);
+            return NULL;
+        }
+    }
+    l->nb_joueurs = nb_joueurs;
+
+    struct sockaddr_in locale;
+    memset(&locale, 0, sizeof(locale));
+    locale.sin_family = AF_INET;
+    locale.sin_addr.s_addr = htonl(INADDR_ANY);
+    locale.sin_port = l->adresses[joueur].sin_port;
+
+    l->prise = socket(AF_INET, SOCK_DGRAM, 0);
+#ifdef _WIN32
+    u_long non_bloquant = 1;
+    int erreur = l->prise == INVALID_SOCKET || ioctlsocket(l->prise, FIONBIO, &non_bloquant) != 0;
+#else
+    int erreur = l->prise < 0 || fcntl(l->prise, F_SETFL, O_NONBLOCK) != 0;
+#endif
+    if (erreur || bind(l->prise, (const struct sockaddr*)&locale, sizeof(locale)) != 0) {
+        printf("erreur: impossible d'ouvrir le port %d\n", ntohs(locale.sin_port));
+        l->transport.donnees = l;
+        fermer_udp(&l->transport);
+        return NULL;
+    }
+
+    l->transport = (transport_reseau){ envoyer_udp, recevoir_udp, fermer_udp, l, joueur };
+    return &l->transport;
+}
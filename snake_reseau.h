@@ -0,0 +1,106 @@
+// parties  plusieurs en rseau: chaque joueur a son plateau (course avec la mme graine)
+// et tous les plateaux avancent ensemble, pas par pas, sur chaque machine
+//
+// une entre locale est joue delai pas aprs avoir t donne, le temps qu'elle arrive
+// chez les autres. une entre distante qui n'est pas encore arrive est prdite
+// (garder la direction); si elle arrive ensuite et diffre de la prdiction,
+// la session revient  l'tat sauvegard avant ce pas (copier_jeu) et rejoue
+// jusqu'au pas courant, dans la mme image
+//
+// les messages passent par un transport: UDP, ou une boucle locale en mmoire
+// (latence, gigue et pertes rglables) pour les essais sans rseau
+#ifndef SNAKE_RESEAU_H
+#define SNAKE_RESEAU_H
+
+#include "snake_moteur.h"
+
+#define nb_joueurs_max 8
+#define historique_reseau 64       // pas gards pour revenir en arrire (puissance de 2)
+#define retour_max (historique_reseau / 2)   // la session attend si une entre distante a plus de retard
+#define entrees_par_message 32
+#define magie_reseau 0x54454e53u   // "SNET"
+
+// message envoy  chaque image  chaque autre joueur:
+// ses entres pas encore accuses, et ce qu'on a reu de lui
+typedef struct {
+    uint32_t magie;
+    uint8_t joueur;                // expditeur
+    uint8_t nb_entrees;
+    int32_t premier_pas;           // pas de la premire entre
+    int32_t accuse;                // dernier pas reu sans trou de la part du destinataire
+    int8_t entrees[entrees_par_message];   // direction, ou -1 pour garder la direction
+} message_reseau;
+
+// transport de messages entre joueurs
+typedef struct transport_reseau transport_reseau;
+struct transport_reseau {
+    int (*envoyer)(transport_reseau* t, int destination, const void* octets, int taille);   // 0 si envoy
+    int (*recevoir)(transport_reseau* t, void* octets, int taille_max);   // taille reue, 0 si rien
+    void (*fermer)(transport_reseau* t);
+    void* donnees;
+    int joueur;
+};
+
+// mesures d'une session
+typedef struct {
+    long long pas;                 // pas jous (sans compter les pas rejous)
+    long long attentes;            // images sans pas: une entre distante avait trop de retard
+    long long predictions_fausses; // entres distantes qui changent la direction prdite
+    long long retours;             // retours en arrire
+    long long pas_rejoues;
+    int profondeur_max;            // plus long retour en arrire (en pas)
+    double secondes_rejeu;         // temps total pass  rejouer
+    double rejeu_max;              // plus long rejeu en une image (secondes)
+    long long messages_envoyes;
+    long long messages_recus;
+} mesures_reseau;
+
+typedef struct {
+    int nb_joueurs;
+    int local;                     // joueur de cette machine
+    int delai;                     // pas entre une entre locale et le pas o elle est joue
+    transport_reseau* transport;
+    int pas_courant;               // prochain pas  jouer
+
+    jeu_snake* jeux[nb_joueurs_max];   // plateau de chaque joueur au pas courant
+    // pour chaque pas de l'historique: tat avant le pas et entres
+    jeu_snake* sauvegardes[historique_reseau][nb_joueurs_max];
+    int8_t entrees[historique_reseau][nb_joueurs_max];     // entres reues (ou locales)
+    int32_t pas_entrees[historique_reseau][nb_joueurs_max];   // pas de l'entre range (sinon inconnue)
+    int8_t utilisees[historique_reseau][nb_joueurs_max];   // entres joues (reues ou prdites)
+
+    int recu[nb_joueurs_max];      // dernier pas dont on a l'entre de chaque joueur, sans trou
+    int accuse[nb_joueurs_max];    // dernier pas de nos entres reu par chaque joueur
+    int premier_faux;              // plus ancien pas jou avec une mauvaise prdiction
+    mesures_reseau mesures;
+} session_reseau;
+
+// cre une session: tous les joueurs commencent avec la mme graine et la mme taille de plateau
+session_reseau* creer_session(int nb_joueurs, int local, int delai, int largeur, int hauteur,
+                              uint64_t graine, transport_reseau* transport);
+void detruire_session(session_reseau* s);
+
+// une image: reoit les messages (et revient en arrire si besoin), joue un pas si possible
+// avec action comme entre locale (joue au pas pas_courant + delai), puis envoie nos entres
+// retourne 1 si un pas a t jou (action utilise), 0 si la session attend
+int avancer_session(session_reseau* s, int action);
+
+// reoit et envoie les entres sans jouer de pas
+void synchroniser_session(session_reseau* s);
+
+// toutes les entres jusqu'au pas courant sont connues: les plateaux ne changeront plus
+int session_confirmee(const session_reseau* s);
+
+// tous les plateaux sont finis et toutes les entres sont connues
+int session_terminee(const session_reseau* s);
+
+// transports
+transport_reseau* ouvrir_udp(int joueur, int nb_joueurs, const char** adresses);   // "hote:port" par joueur
+
+typedef struct boucle_locale boucle_locale;
+boucle_locale* creer_boucle_locale(int nb_joueurs, int latence, int gigue, int pertes_pour_mille, uint64_t graine);
+transport_reseau* transport_boucle(boucle_locale* boucle, int joueur);
+void avancer_boucle(boucle_locale* boucle);   // une image de plus: les messages arrivs sont livrs
+void detruire_boucle_locale(boucle_locale* boucle);
+
+#endif
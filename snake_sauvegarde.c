@@ -0,0 +1,306 @@
+// image d'une partie (voir snake_sauvegarde.h)
+#include "snake_sauvegarde.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// fonction pour compter les blocs allous d'un jeu
+static int blocs_alloues(const jeu_snake* jeu) {
+    int nombre = 0;
+    for (int i = 0; i < jeu->largeur_blocs * jeu->hauteur_blocs; i++) {
+        if (jeu->blocs[i] != NULL) nombre++;
+    }
+    return nombre;
+}
+
+// fonction pour vrifier que les liens de la roue des minuteurs restent dans la roue
+static int roue_valide(const roue_minuteurs* roue) {
+    for (int i = 0; i < taille_roue; i++) {
+        if (roue->cases[i] < -1 || roue->cases[i] >= nb_minuteurs) return 0;
+    }
+    for (int i = 0; i < nb_minuteurs; i++) {
+        const minuteur* m = &roue->minuteurs[i];
+        if (m->suivant < -1 || m->suivant >= nb_minuteurs ||
+            m->precedent < -1 || m->precedent >= nb_minuteurs) return 0;
+    }
+    return 1;
+}
+
+// fonction pour vrifier qu'une position est sur le plateau de l'image
+static int position_valide(const entete_image* entete, position pos) {
+    return pos.x >= 0 && pos.x < entete->largeur && pos.y >= 0 && pos.y < entete->hauteur;
+}
+
+// fonction pour vrifier un bloc de l'image avant de le recopier tel quel:
+// contenus connus, et liste des cases vides cohrente (chaque case vide du plateau
+// y est une fois,  la place note dans place; les cases hors du plateau n'y sont pas)
+static int bloc_valide(const entete_image* entete, const bloc_image* image) {
+    const bloc_plateau* bloc = &image->bloc;
+    int largeur_blocs = (entete->largeur + cote_bloc - 1) / cote_bloc;
+    int x0 = (image->numero % largeur_blocs) * cote_bloc;
+    int y0 = (image->numero / largeur_blocs) * cote_bloc;
+    int largeur = entete->largeur - x0 < cote_bloc ? entete->largeur - x0 : cote_bloc;
+    int hauteur = entete->hauteur - y0 < cote_bloc ? entete->hauteur - y0 : cote_bloc;
+
+    if (bloc->nb_libres < 0 || bloc->nb_libres > largeur * hauteur) return 0;
+
+    int libres = 0;
+    for (int c = 0; c < cases_bloc; c++) {
+        int dedans = c % cote_bloc < largeur && c / cote_bloc < hauteur;
+        int place = bloc->place[c];
+        if (bloc->cases[c] > case_mur) return 0;
+        if (place == aucune_place) {
+            if (dedans && bloc->cases[c] == case_vide) return 0;  // case vide absente de la liste
+            continue;
+        }
+        if (!dedans || bloc->cases[c] != case_vide || place >= bloc->nb_libres || bloc->libres[place] != c) return 0;
+        libres++;
+    }
+    return libres == bloc->nb_libres;
+}
+
+// fonction pour vrifier tout ce que la reprise utilise comme indice ou comme position
+// (avant de toucher au jeu: une image refuse le laisse tel qu'il tait)
+static int image_valide(const entete_image* entete, const unsigned char* octets) {
+    if (entete->largeur < 5 || entete->hauteur < 1 || (long long)entete->largeur * entete->hauteur > 1000000000 ||
+        entete->longueur > entete->largeur * entete->hauteur || entete->croissance < 0 ||
+        entete->dir_actuelle < dir_haut || entete->dir_actuelle > dir_droite ||
+        entete->dernier_bonus < fruit_normal || entete->dernier_bonus > fruit_bonus_taille) {
+        return 0;
+    }
+
+    // le corps (l'image n'est pas forcment aligne: les positions sont recopies une  une)
+    for (int i = 0; i < entete->longueur; i++) {
+        position pos;
+        memcpy(&pos, octets + entete->decalage_corps + (size_t)i * sizeof(position), sizeof(position));
+        if (!position_valide(entete, pos)) return 0;
+    }
+
+    // la nourriture (-1 s'il n'y en a pas) et les fruits dont la case peut encore tre libre
+    if (!(entete->nourriture.x == -1 && entete->nourriture.y == -1) && !position_valide(entete, entete->nourriture)) {
+        return 0;
+    }
+    for (int k = 0; k < nb_fruits_max; k++) {
+        const fruit* f = &entete->fruits[k];
+        int arme = entete->minuteurs.minuteurs[minuteur_fruits + k].echeance >= 0;
+        if ((f->actif || arme) && !position_valide(entete, f->pos)) return 0;
+        if (f->type < fruit_normal || f->type > fruit_bonus_taille) return 0;
+    }
+
+    // les blocs, rangs par numro croissant
+    const bloc_image* blocs = (const bloc_image*)(octets + entete->decalage_blocs);
+    long long blocs_plateau = (long long)((entete->largeur + cote_bloc - 1) / cote_bloc) *
+                              ((entete->hauteur + cote_bloc - 1) / cote_bloc);
+    for (int i = 0; i < entete->nb_blocs; i++) {
+        if (blocs[i].numero < 0 || blocs[i].numero >= blocs_plateau ||
+            (i > 0 && blocs[i].numero <= blocs[i - 1].numero) || !bloc_valide(entete, &blocs[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// fonction pour calculer la taille de l'image d'un jeu
+size_t taille_image(const jeu_snake* jeu) {
+    return sizeof(entete_image) + (size_t)jeu->longueur * sizeof(position) +
+           (size_t)blocs_alloues(jeu) * sizeof(bloc_image);
+}
+
+// fonction pour crire l'image d'un jeu
+size_t ecrire_image(const jeu_snake* jeu, void* tampon) {
+    unsigned char* octets = (unsigned char*)tampon;
+    entete_image* entete = (entete_image*)tampon;
+    memset(entete, 0, sizeof(entete_image));
+
+    entete->magie = magie_image;
+    entete->largeur = jeu->largeur;
+    entete->hauteur = jeu->hauteur;
+    entete->longueur = jeu->longueur;
+    entete->croissance = jeu->croissance;
+    entete->dir_actuelle = jeu->dir_actuelle;
+    entete->nourriture = jeu->nourriture;
+    memcpy(entete->fruits, jeu->fruits, sizeof(entete->fruits));
+    entete->dernier_bonus = jeu->dernier_bonus;
+    entete->score = jeu->score;
+    entete->game_over = jeu->game_over;
+    entete->en_pause = jeu->en_pause;
+    entete->en_menu = jeu->en_menu;
+    entete->vitesse_normale = jeu->vitesse_normale;
+    entete->vitesse_rapide = jeu->vitesse_rapide;
+    entete->nb_pas = jeu->nb_pas;
+    entete->hasard = jeu->hasard;
+    entete->minuteurs = jeu->minuteurs;
+
+    // corps de la queue  la tte
+    entete->decalage_corps = sizeof(entete_image);
+    position* corps = (position*)(octets + entete->decalage_corps);
+    for (int i = 0; i < jeu->longueur; i++) {
+        corps[i] = jeu->corps[(jeu->indice_queue + i) & (jeu->capacite_corps - 1)];
+    }
+
+    // blocs allous, recopis tels quels
+    entete->decalage_blocs = entete->decalage_corps + jeu->longueur * sizeof(position);
+    bloc_image* blocs = (bloc_image*)(octets + entete->decalage_blocs);
+    for (int i = 0; i < jeu->largeur_blocs * jeu->hauteur_blocs; i++) {
+        if (jeu->blocs[i] != NULL) {
+            blocs[entete->nb_blocs].numero = i;
+            memcpy(&blocs[entete->nb_blocs].bloc, jeu->blocs[i], sizeof(bloc_plateau));
+            entete->nb_blocs++;
+        }
+    }
+
+    entete->taille = entete->decalage_blocs + entete->nb_blocs * sizeof(bloc_image);
+    return entete->taille;
+}
+
+// fonction pour remettre un jeu dans l'tat d'une image
+// la mmoire du jeu est rutilise quand le plateau a la mme taille:
+// les blocs de l'image sont recopis tels quels, sans aucune conversion
+// retourne 0 si tout s'est bien pass
+int restaurer_image(jeu_snake* jeu, const void* tampon, size_t taille) {
+    const unsigned char* octets = (const unsigned char*)tampon;
+    const entete_image* entete = (const entete_image*)tampon;
+
+    // vrifier que l'image est complte et cohrente
+    if (taille < sizeof(entete_image) || entete->magie != magie_image || entete->taille > taille ||
+        entete->longueur < 1 || entete->nb_blocs < 0 || !roue_valide(&entete->minuteurs) ||
+        entete->decalage_corps + (size_t)entete->longueur * sizeof(position) > entete->taille ||
+        entete->decalage_blocs + (size_t)entete->nb_blocs * sizeof(bloc_image) > entete->taille ||
+        !image_valide(entete, octets)) {
+        printf("erreur: image de partie invalide\n");
+        return 1;
+    }
+    const bloc_image* blocs = (const bloc_image*)(octets + entete->decalage_blocs);
+    if (redimensionner_jeu(jeu, entete->largeur, entete->hauteur) != 0 ||
+        reserver_corps(jeu, entete->longueur) != 0) {
+        return 1;
+    }
+
+    // blocs de l'image (rangs par numro croissant); les autres sont vids
+    int nb_blocs = jeu->largeur_blocs * jeu->hauteur_blocs;
+    int suivant = 0;
+    for (int i = 0; i < nb_blocs; i++) {
+        if (suivant < entete->nb_blocs && blocs[suivant].numero == i) {
+            bloc_plateau* bloc = bloc_alloue(jeu, i);
+            if (bloc == NULL) {
+                return 1;
+            }
+            memcpy(bloc, &blocs[suivant].bloc, sizeof(bloc_plateau));
+            suivant++;
+        } else {
+            vider_bloc(jeu, i);
+        }
+    }
+    recalculer_libres(jeu);
+
+    const position* corps = (const position*)(octets + entete->decalage_corps);
+    memcpy(jeu->corps, corps, entete->longueur * sizeof(position));
+    jeu->indice_queue = 0;
+    jeu->indice_tete = entete->longueur - 1;
+    jeu->longueur = entete->longueur;
+    jeu->croissance = entete->croissance;
+
+    jeu->dir_actuelle = (direction)entete->dir_actuelle;
+    jeu->nourriture = entete->nourriture;
+    memcpy(jeu->fruits, entete->fruits, sizeof(jeu->fruits));
+    jeu->dernier_bonus = (type_fruit)entete->dernier_bonus;
+    jeu->score = entete->score;
+    jeu->game_over = entete->game_over;
+    jeu->en_pause = entete->en_pause;
+    jeu->en_menu = entete->en_menu;
+    jeu->vitesse_normale = entete->vitesse_normale;
+    jeu->vitesse_rapide = entete->vitesse_rapide;
+    jeu->nb_pas = entete->nb_pas;
+    jeu->hasard = entete->hasard;
+    jeu->minuteurs = entete->minuteurs;
+    return 0;
+}
+
+// fonction pour crer un jeu  partir de son image
+jeu_snake* lire_image(const void* tampon, size_t taille) {
+    const entete_image* entete = (const entete_image*)tampon;
+    if (taille < sizeof(entete_image) || entete->magie != magie_image) {
+        printf("erreur: image de partie invalide\n");
+        return NULL;
+    }
+
+    jeu_snake* jeu = allouer_jeu(entete->largeur, entete->hauteur);
+    if (jeu != NULL && restaurer_image(jeu, tampon, taille) != 0) {
+        detruire_jeu(jeu);
+        return NULL;
+    }
+    return jeu;
+}
+
+// fonction pour sauvegarder une partie: l'image est crite d'un seul bloc
+// retourne 0 si tout s'est bien pass
+int sauvegarder_jeu(const jeu_snake* jeu, const char* chemin) {
+    size_t taille = taille_image(jeu);
+    void* image = malloc(taille);
+    if (image == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour la sauvegarde\n");
+        return 1;
+    }
+    ecrire_image(jeu, image);
+
+    FILE* fichier = fopen(chemin, "wb");
+    int erreur = fichier == NULL || fwrite(image, 1, taille, fichier) != taille;
+    if (fichier != NULL && fclose(fichier) != 0) {
+        erreur = 1;
+    }
+    if (erreur) {
+        printf("erreur: impossible d'crire %s\n", chemin);
+    }
+    free(image);
+    return erreur;
+}
+
+// fonction pour reprendre une partie sauvegarde dans un jeu existant
+// le fichier est projet en mmoire et restaur directement depuis la projection
+// retourne 0 si tout s'est bien pass
+int charger_jeu(jeu_snake* jeu, const char* chemin) {
+#ifdef _WIN32
+    // pas de mmap: le fichier est lu d'un seul bloc
+    FILE* fichier = fopen(chemin, "rb");
+    if (fichier == NULL) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return 1;
+    }
+    fseek(fichier, 0, SEEK_END);
+    long taille = ftell(fichier);
+    fseek(fichier, 0, SEEK_SET);
+    void* image = taille > 0 ? malloc(taille) : NULL;
+    int erreur = image == NULL || fread(image, 1, taille, fichier) != (size_t)taille ||
+                 restaurer_image(jeu, image, taille) != 0;
+    free(image);
+    fclose(fichier);
+    return erreur;
+#else
+    int descripteur = open(chemin, O_RDONLY);
+    if (descripteur < 0) {
+        printf("erreur: impossible d'ouvrir %s\n", chemin);
+        return 1;
+    }
+    struct stat infos;
+    if (fstat(descripteur, &infos) != 0 || infos.st_size == 0) {
+        printf("erreur: %s est vide\n", chemin);
+        close(descripteur);
+        return 1;
+    }
+    void* image = mmap(NULL, infos.st_size, PROT_READ, MAP_PRIVATE, descripteur, 0);
+    close(descripteur);
+    if (image == MAP_FAILED) {
+        printf("erreur: impossible de projeter %s en mmoire\n", chemin);
+        return 1;
+    }
+    int erreur = restaurer_image(jeu, image, infos.st_size);
+    munmap(image, infos.st_size);
+    return erreur;
+#endif
+}
@@ -0,0 +1,64 @@
+// image d'une partie: tout l'tat d'un jeu_snake dans un seul bloc de mmoire
+// l'image ne contient aucun pointeur (seulement des dcalages depuis son dbut):
+// elle peut tre crite telle quelle dans un fichier et relue  une autre adresse
+// (les entiers sont dans l'ordre de la machine qui l'a crite)
+// la reprise ne fait que des copies: les blocs sont rangs comme en mmoire
+#ifndef SNAKE_SAUVEGARDE_H
+#define SNAKE_SAUVEGARDE_H
+
+#include "snake_moteur.h"
+#include <stddef.h>
+
+#define magie_image 0x324b4e53u    // "SNK2" (rserve de fruits et roue des minuteurs)
+
+// en-tte de l'image, suivi du corps puis des blocs allous
+typedef struct {
+    uint32_t magie;                // magie_image
+    uint32_t taille;               // taille totale de l'image en octets
+    int32_t largeur;
+    int32_t hauteur;
+    int32_t longueur;              // segments du corps rangs  partir de decalage_corps
+    int32_t croissance;
+    int32_t nb_blocs;              // blocs allous rangs  partir de decalage_blocs
+    int32_t dir_actuelle;
+    position nourriture;
+    fruit fruits[nb_fruits_max];
+    int32_t dernier_bonus;
+    int32_t score;
+    int32_t game_over;
+    int32_t en_pause;
+    int32_t en_menu;
+    int32_t vitesse_normale;
+    int32_t vitesse_rapide;
+    int32_t nb_pas;
+    generateur hasard;
+    roue_minuteurs minuteurs;
+    uint32_t decalage_corps;       // positions de la queue  la tte
+    uint32_t decalage_blocs;       // suite de bloc_image
+} entete_image;
+
+// un bloc allou dans l'image
+typedef struct {
+    int32_t numero;                // numro du bloc dans le plateau
+    bloc_plateau bloc;
+} bloc_image;
+
+// taille de l'image d'un jeu en octets
+size_t taille_image(const jeu_snake* jeu);
+
+// crit l'image du jeu dans tampon (au moins taille_image octets); retourne sa taille
+size_t ecrire_image(const jeu_snake* jeu, void* tampon);
+
+// remet un jeu existant dans l'tat de l'image (sans allocation si le plateau
+// a la mme taille); retourne 0 si russi
+int restaurer_image(jeu_snake* jeu, const void* tampon, size_t taille);
+
+// cre un jeu  partir d'une image; retourne NULL si l'image est invalide
+jeu_snake* lire_image(const void* tampon, size_t taille);
+
+// sauvegarde dans un fichier (une seule criture) et reprise (fichier projet en mmoire)
+// retournent 0 si russi
+int sauvegarder_jeu(const jeu_snake* jeu, const char* chemin);
+int charger_jeu(jeu_snake* jeu, const char* chemin);
+
+#endif
@@ -0,0 +1,118 @@
+// effets sonores mlangs par le fil audio (voir snake_son.h)
+#include "snake_son.h"
+#include <stdatomic.h>
+#include <string.h>
+
+// fonction pour prparer un mixeur vide
+void initialiser_mixeur(mixeur_son* m) {
+    memset(m, 0, sizeof(mixeur_son));
+    m->pas_courant = -1;
+    m->volume = 1.0f;
+    for (int v = 0; v < nb_voix_mixeur; v++) {
+        m->voix[v].effet = -1;
+    }
+}
+
+// fonction pour rendre un effet jouable
+void installer_son(mixeur_son* m, effet_son effet, const float* echantillons, int nb_images) {
+    m->effets[effet].nb_images = nb_images;
+    // publier le pointeur aprs le nombre d'images
+    atomic_store_explicit(&m->effets[effet].echantillons, echantillons, memory_order_release);
+}
+
+// fonction pour dposer un effet (ct jeu)
+void emettre_son(mixeur_son* m, effet_son effet, int pas) {
+    if (m == NULL) return;
+
+    // un mme effet n'est dpos qu'une fois par pas
+    if (pas != m->pas_courant) {
+        m->pas_courant = pas;
+        m->effets_du_pas = 0;
+    }
+    if (m->effets_du_pas & (1u << effet)) {
+        atomic_fetch_add_explicit(&m->fusionnes, 1, memory_order_relaxed);
+        return;
+    }
+    m->effets_du_pas |= 1u << effet;
+
+    uint32_t ecriture = atomic_load_explicit(&m->ecriture, memory_order_relaxed);
+    uint32_t lecture = atomic_load_explicit(&m->lecture, memory_order_acquire);
+
+    // file pleine: oublier le son plutt que d'attendre
+    if (ecriture - lecture >= taille_file_sons) {
+        atomic_fetch_add_explicit(&m->perdus, 1, memory_order_relaxed);
+        return;
+    }
+
+    evenement_son* e = &m->file[ecriture & (taille_file_sons - 1)];
+    e->effet = (uint16_t)effet;
+    e->pas = pas;
+    atomic_store_explicit(&m->ecriture, ecriture + 1, memory_order_release);
+}
+
+// fonction pour dmarrer un effet sur une voix libre
+// (si toutes sont prises, la voix la plus avance dans son effet recommence)
+static void demarrer_voix(mixeur_son* m, int effet) {
+    int choisie = 0;
+    for (int v = 0; v < nb_voix_mixeur; v++) {
+        if (m->voix[v].effet < 0) {
+            choisie = v;
+            break;
+        }
+        if (m->voix[v].position > m->voix[choisie].position) {
+            choisie = v;
+        }
+    }
+    m->voix[choisie].effet = effet;
+    m->voix[choisie].position = 0;
+}
+
+// fonction appele par le fil audio pour remplir le tampon de sortie
+void mixer_sons(mixeur_son* m, float* sortie, int nb_images) {
+    // prendre les nouveaux vnements; les effets dposs entre deux tampons
+    // commencent ensemble, un effet rpt n'est donc dmarr qu'une fois
+    uint32_t lecture = atomic_load_explicit(&m->lecture, memory_order_relaxed);
+    uint32_t ecriture = atomic_load_explicit(&m->ecriture, memory_order_acquire);
+    uint32_t demarres = 0;
+    while (lecture != ecriture) {
+        int effet = m->file[lecture & (taille_file_sons - 1)].effet;
+        lecture++;
+        if (effet >= nb_sons) continue;
+        if (demarres & (1u << effet)) {
+            atomic_fetch_add_explicit(&m->fusionnes, 1, memory_order_relaxed);
+            continue;
+        }
+        demarres |= 1u << effet;
+        if (atomic_load_explicit(&m->effets[effet].echantillons, memory_order_acquire) != NULL) {
+            demarrer_voix(m, effet);
+        }
+    }
+    atomic_store_explicit(&m->lecture, lecture, memory_order_release);
+
+    // additionner les voix actives
+    memset(sortie, 0, sizeof(float) * nb_images * canaux_mixeur);
+    for (int v = 0; v < nb_voix_mixeur; v++) {
+        voix_son* voix = &m->voix[v];
+        if (voix->effet < 0) continue;
+
+        const echantillons_son* effet = &m->effets[voix->effet];
+        const float* echantillons = atomic_load_explicit(&effet->echantillons, memory_order_acquire);
+        int images = effet->nb_images - voix->position;
+        if (images > nb_images) images = nb_images;
+
+        const float* source = echantillons + (size_t)voix->position * canaux_mixeur;
+        for (int i = 0; i < images * canaux_mixeur; i++) {
+            sortie[i] += source[i] * m->volume;
+        }
+        voix->position += images;
+        if (voix->position >= effet->nb_images) {
+            voix->effet = -1;   // effet termin: la voix est libre
+        }
+    }
+
+    // viter la saturation quand plusieurs effets se superposent
+    for (int i = 0; i < nb_images * canaux_mixeur; i++) {
+        if (sortie[i] > 1.0f) sortie[i] = 1.0f;
+        if (sortie[i] < -1.0f) sortie[i] = -1.0f;
+    }
+}
@@ -0,0 +1,73 @@
+// effets sonores: le jeu dpose des vnements dans une file sans verrou
+// (un seul producteur, un seul consommateur) et le fil audio les mlange lui-mme
+// le jeu n'appelle jamais l'audio: dposer un son ne cote qu'une criture en mmoire,
+// et les programmes sans fentre n'ont aucun mixeur (aucun cot audio)
+//
+// le mme effet demand plusieurs fois pendant un pas n'est jou qu'une fois
+#ifndef SNAKE_SON_H
+#define SNAKE_SON_H
+
+#include <stdint.h>
+
+#define taille_file_sons 256       // vnements en attente (puissance de 2)
+#define nb_voix_mixeur 16          // effets jous en mme temps au plus
+#define canaux_mixeur 2            // chantillons float entrelacs, en stro
+#define frequence_mixeur 44100
+
+// effets connus du mixeur
+typedef enum {
+    son_manger = 0,
+    son_bonus,
+    son_vitesse,
+    son_game_over,
+    nb_sons
+} effet_son;
+
+// un vnement: l'effet et le pas qui l'a produit
+typedef struct {
+    uint16_t effet;
+    int32_t pas;
+} evenement_son;
+
+// chantillons d'un effet (publis par installer_son, lus par le fil audio)
+typedef struct {
+    _Atomic(const float*) echantillons;   // NULL tant que l'effet n'est pas charg
+    int nb_images;                        // une image = canaux_mixeur chantillons
+} echantillons_son;
+
+// une voix en train de jouer (utilise seulement par le fil audio)
+typedef struct {
+    int effet;                     // -1 si la voix est libre
+    int position;                  // image suivante  jouer
+} voix_son;
+
+typedef struct {
+    evenement_son file[taille_file_sons];
+    _Atomic uint32_t ecriture;     // vnements dposs (modifi par le jeu)
+    char separation1[60];          // le jeu et le fil audio crivent sur des lignes de cache diffrentes
+    _Atomic uint32_t lecture;      // vnements pris (modifi par le fil audio)
+    char separation2[60];
+    // ct jeu
+    int pas_courant;               // pas des derniers effets dposs
+    uint32_t effets_du_pas;        // effets dj dposs pour ce pas (un bit par effet)
+    // ct fil audio
+    voix_son voix[nb_voix_mixeur];
+    float volume;
+    echantillons_son effets[nb_sons];
+    _Atomic long long perdus;      // vnements oublis (file pleine)
+    _Atomic long long fusionnes;   // doublons d'un mme pas
+} mixeur_son;
+
+// prpare un mixeur vide (sans effet charg)
+void initialiser_mixeur(mixeur_son* m);
+
+// rend un effet jouable; les chantillons doivent vivre jusqu' l'arrt du fil audio
+void installer_son(mixeur_son* m, effet_son effet, const float* echantillons, int nb_images);
+
+// dpose un effet (ct jeu, ne bloque jamais; m peut tre NULL)
+void emettre_son(mixeur_son* m, effet_son effet, int pas);
+
+// ct fil audio: prend les vnements en attente et remplit nb_images images de sortie
+void mixer_sons(mixeur_son* m, float* sortie, int nb_images);
+
+#endif
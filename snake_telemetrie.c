@@ -0,0 +1,129 @@
+// tlmtrie en arrire-plan (voir snake_telemetrie.h)
+#include "snake_telemetrie.h"
+#include "snake_moteur.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+// noms des types d'vnements dans le journal
+static const char* noms_telemetrie[] = {
+    "debut_partie", "score", "fruit", "vitesse_debut", "vitesse_fin", "game_over"
+};
+
+struct telemetrie {
+    evenement_telemetrie tampon[taille_tampon_telemetrie];
+    _Atomic uint32_t ecriture;     // nombre d'vnements dposs (modifi par le jeu)
+    char separation1[60];          // le jeu et le fil crivent sur des lignes de cache diffrentes
+    _Atomic uint32_t lecture;      // nombre d'vnements crits (modifi par le fil)
+    char separation2[60];
+    _Atomic int arret;             // demande d'arrt du fil
+    _Atomic long long perdus;      // vnements oublis (tampon plein)
+    double depart;                 // instant du dmarrage
+    FILE* fichier;
+    pthread_t fil;
+};
+
+// fonction pour crire dans le fichier tous les vnements en attente
+static void vider_tampon(telemetrie* tel) {
+    uint32_t lecture = atomic_load_explicit(&tel->lecture, memory_order_relaxed);
+    uint32_t ecriture = atomic_load_explicit(&tel->ecriture, memory_order_acquire);
+
+    while (lecture != ecriture) {
+        const evenement_telemetrie* e = &tel->tampon[lecture & (taille_tampon_telemetrie - 1)];
+        fprintf(tel->fichier, "{\"t\":%.6f,\"type\":\"%s\",\"detail\":%u,\"pas\":%d,\"score\":%d,\"longueur\":%d}\n",
+                e->instant, e->type < 6 ? noms_telemetrie[e->type] : "inconnu",
+                e->detail, e->pas, e->score, e->longueur);
+        lecture++;
+        // rendre la place au jeu au fur et  mesure
+        atomic_store_explicit(&tel->lecture, lecture, memory_order_release);
+    }
+}
+
+// fonction excute par le fil d'criture
+static void* boucle_telemetrie(void* argument) {
+    telemetrie* tel = (telemetrie*)argument;
+    struct timespec pause = { 0, 10 * 1000 * 1000 };  // 10 ms
+
+    while (!atomic_load_explicit(&tel->arret, memory_order_acquire)) {
+        vider_tampon(tel);
+        fflush(tel->fichier);
+        nanosleep(&pause, NULL);
+    }
+
+    // derniers vnements dposs avant l'arrt
+    vider_tampon(tel);
+    return NULL;
+}
+
+// fonction pour dmarrer la tlmtrie
+telemetrie* demarrer_telemetrie(const char* chemin) {
+    telemetrie* tel = (telemetrie*)calloc(1, sizeof(telemetrie));
+    if (tel == NULL) {
+        printf("erreur: impossible d'allouer de la mmoire pour la tlmtrie\n");
+        return NULL;
+    }
+
+    tel->fichier = fopen(chemin, "w");
+    if (tel->fichier == NULL) {
+        printf("erreur: impossible d'ouvrir le journal %s\n", chemin);
+        free(tel);
+        return NULL;
+    }
+
+    tel->depart = horloge_secondes();
+    if (pthread_create(&tel->fil, NULL, boucle_telemetrie, tel) != 0) {
+        printf("erreur: impossible de dmarrer le fil de tlmtrie\n");
+        fclose(tel->fichier);
+        free(tel);
+        return NULL;
+    }
+
+    return tel;
+}
+
+// fonction pour dposer un vnement (ct jeu)
+void noter_telemetrie(telemetrie* tel, type_telemetrie type, int detail, int pas, int score, int longueur) {
+    if (tel == NULL) return;
+
+    uint32_t ecriture = atomic_load_explicit(&tel->ecriture, memory_order_relaxed);
+    uint32_t lecture = atomic_load_explicit(&tel->lecture, memory_order_acquire);
+
+    // tampon plein: oublier l'vnement plutt que d'attendre
+    if (ecriture - lecture >= taille_tampon_telemetrie) {
+        atomic_fetch_add_explicit(&tel->perdus, 1, memory_order_relaxed);
+        return;
+    }
+
+    evenement_telemetrie* e = &tel->tampon[ecriture & (taille_tampon_telemetrie - 1)];
+    e->type = (uint16_t)type;
+    e->detail = (uint16_t)detail;
+    e->pas = pas;
+    e->score = score;
+    e->longueur = longueur;
+    e->instant = horloge_secondes() - tel->depart;
+
+    // publier l'vnement une fois rempli
+    atomic_store_explicit(&tel->ecriture, ecriture + 1, memory_order_release);
+}
+
+// fonction pour arrter la tlmtrie
+void arreter_telemetrie(telemetrie* tel) {
+    if (tel == NULL) return;
+
+    atomic_store_explicit(&tel->arret, 1, memory_order_release);
+    pthread_join(tel->fil, NULL);
+
+    long long perdus = atomic_load(&tel->perdus);
+    if (perdus > 0) {
+        fprintf(tel->fichier, "{\"type\":\"perdus\",\"nombre\":%lld}\n", perdus);
+    }
+    fclose(tel->fichier);
+    free(tel);
+}
+
+// fonction pour connatre le nombre d'vnements perdus
+long long evenements_perdus(const telemetrie* tel) {
+    return tel == NULL ? 0 : atomic_load(&tel->perdus);
+}
@@ -0,0 +1,47 @@
+// tlmtrie: journal des vnements de jeu crit par un fil en arrire-plan
+// le jeu dpose des vnements de taille fixe dans un tampon circulaire sans verrou
+// (un seul producteur, un seul consommateur); le fil les crit en NDJSON
+// (un objet JSON par ligne). si le tampon est plein, l'vnement est compt puis oubli:
+// le jeu n'attend jamais le disque
+#ifndef SNAKE_TELEMETRIE_H
+#define SNAKE_TELEMETRIE_H
+
+#include <stdint.h>
+
+#define taille_tampon_telemetrie 4096   // nombre d'vnements en attente (puissance de 2)
+
+// types d'vnements enregistrs
+typedef enum {
+    telemetrie_debut_partie = 0,   // nouvelle partie (detail: rien)
+    telemetrie_score,              // le score a chang
+    telemetrie_fruit,              // fruit mang (detail: type_fruit)
+    telemetrie_vitesse_debut,      // dbut du bonus de vitesse
+    telemetrie_vitesse_fin,        // fin du bonus de vitesse
+    telemetrie_game_over           // fin de partie (detail: evenement_mort_mur ou evenement_mort_serpent)
+} type_telemetrie;
+
+// un vnement: copi tel quel dans le tampon
+typedef struct {
+    uint16_t type;                 // type_telemetrie
+    uint16_t detail;               // prcision selon le type
+    int32_t pas;                   // numro du pas dans la partie
+    int32_t score;
+    int32_t longueur;
+    double instant;                // secondes depuis le dmarrage de la tlmtrie
+} evenement_telemetrie;
+
+typedef struct telemetrie telemetrie;
+
+// dmarre le fil d'criture vers un fichier; retourne NULL si impossible
+telemetrie* demarrer_telemetrie(const char* chemin);
+
+// dpose un vnement (appel par le jeu, ne bloque jamais)
+void noter_telemetrie(telemetrie* tel, type_telemetrie type, int detail, int pas, int score, int longueur);
+
+// crit les derniers vnements, arrte le fil et ferme le fichier
+void arreter_telemetrie(telemetrie* tel);
+
+// nombre d'vnements perdus parce que le tampon tait plein
+long long evenements_perdus(const telemetrie* tel);
+
+#endif